@@ -13,6 +13,19 @@
 
 namespace vecpar {
 
+#if defined(_OPENMP)
+/// container initialization and conversion on the host, with every backend
+using vecpar::omp::parallel_copy;
+using vecpar::omp::parallel_fill;
+using vecpar::omp::parallel_generate;
+using vecpar::omp::parallel_iota;
+using vecpar::omp::parallel_make_jagged;
+using vecpar::omp::parallel_make_jagged_from_offsets;
+using vecpar::omp::parallel_make_vector;
+using vecpar::omp::parallel_to_aos;
+using vecpar::omp::parallel_to_soa;
+#endif
+
 template <class Algorithm, class MemoryResource,
           typename R = typename Algorithm::intermediate_result_t, typename T,
           typename... Arguments>
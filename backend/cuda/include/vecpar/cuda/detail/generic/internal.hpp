@@ -1,6 +1,7 @@
 #ifndef VECPAR_RAW_INTERNAL_HPP
 #define VECPAR_RAW_INTERNAL_HPP
 
+#include "vecpar/core/algorithms/detail/map.hpp"
 #include "vecpar/cuda/detail/common/config.hpp"
 #include "vecpar/cuda/detail/common/cuda_utils.hpp"
 #include "vecpar/cuda/detail/common/kernels.hpp"
@@ -37,7 +38,7 @@ requires detail::is_mmap<Algorithm, T, Arguments...>
       kernel<<<config.m_gridSize, config.m_blockSize, config.m_memorySize>>>(
           input.size,
           [=] __device__(int idx, Arguments... a) {
-        algorithm.mapping_function(input.ptr[idx], a...);
+        vecpar::detail::call_mapping_function(algorithm, idx, input.ptr[idx], a...);
           },
           args...);
 
@@ -71,7 +72,7 @@ requires detail::is_map<Algorithm, R, T, Arguments...>
       kernel<<<config.m_gridSize, config.m_blockSize, config.m_memorySize>>>(
           input.size,
           [=] __device__(int idx, Arguments... a) {
-        algorithm.mapping_function(d_result[idx], input.ptr[idx], a...);
+        vecpar::detail::call_mapping_function(algorithm, idx, d_result[idx], input.ptr[idx], a...);
           },
           args...);
 
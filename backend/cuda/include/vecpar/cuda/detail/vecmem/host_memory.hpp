@@ -15,7 +15,8 @@ template <typename... T>
 std::tuple<std::conditional_t<
     (std::is_object<T>::value && Jagged_vector_type<T>),
     vecmem::data::jagged_vector_data<value_type_t<T>>,
-    std::conditional_t<(std::is_object<T>::value && Vector_type<T>),
+    std::conditional_t<(std::is_object<T>::value &&
+                        (Vector_type<T> || Span_view_type<T>)),
                        vecmem::data::vector_buffer<value_type_t<T>>, T>>...>
 get_buffer_of_copied_container_or_obj(T &...obj) {
   return {([](T &i) {
@@ -26,6 +27,10 @@ get_buffer_of_copied_container_or_obj(T &...obj) {
       auto buffer = internal::copy.to(vecmem::get_data(i), internal::d_mem,
                                       vecmem::copy::type::host_to_device);
       return buffer;
+    } else if constexpr (Span_view_type<T>) {
+      auto buffer = internal::copy.to(get_span_data(i), internal::d_mem,
+                                      vecmem::copy::type::host_to_device);
+      return buffer;
     } else {
       return i;
     }
@@ -38,6 +43,13 @@ template <typename Algorithm,
 requires vecpar::detail::is_map<Algorithm, R, T, Arguments...> R &
 parallel_map(Algorithm algorithm, vecmem::host_memory_resource &mr,
              vecpar::config config, T &data, Arguments &...args) {
+  static_assert(!vecpar::collection::Any_soa_vector<R, T, Arguments...>,
+                "soa_vector is supported by the OpenMP backend only");
+  static_assert(!vecpar::collection::Any_lazy_range<R, T, Arguments...>,
+                "lazy ranges are supported by the OpenMP backend only");
+  static_assert(!vecpar::collection::Any_strided_view<R, T, Arguments...>,
+                "strided views are supported by the OpenMP backend only, the "
+                "CUDA backend copies contiguous storage");
 
   auto fn_jagged = [&]<typename... P>(P & ...obj)
                        ->std::tuple<std::conditional_t<
@@ -94,9 +106,16 @@ parallel_map(Algorithm algorithm, vecmem::host_memory_resource &mr, T &data,
 template <typename Algorithm,
           typename R = typename Algorithm::intermediate_result_t, typename T,
           typename... Arguments>
-requires vecpar::detail::is_mmap<Algorithm, R, Arguments...> R &
+requires vecpar::detail::is_mmap<Algorithm, R, Arguments...> T &
 parallel_map(Algorithm algorithm, vecmem::host_memory_resource &mr,
              vecpar::config config, T &data, Arguments &...args) {
+  static_assert(!vecpar::collection::Any_soa_vector<R, T, Arguments...>,
+                "soa_vector is supported by the OpenMP backend only");
+  static_assert(!vecpar::collection::Any_lazy_range<R, T, Arguments...>,
+                "lazy ranges are supported by the OpenMP backend only");
+  static_assert(!vecpar::collection::Any_strided_view<R, T, Arguments...>,
+                "strided views are supported by the OpenMP backend only, the "
+                "CUDA backend copies contiguous storage");
 
   auto fn_jagged =
       [&]<typename... P>(P & ...obj)
@@ -135,14 +154,18 @@ parallel_map(Algorithm algorithm, vecmem::host_memory_resource &mr,
 
   std::apply(fn, input_j);
 
-  internal::copy(data_buffer, data, vecmem::copy::type::device_to_host);
+  if constexpr (Span_view_type<T>)
+    internal::copy(data_buffer, get_span_data(data),
+                   vecmem::copy::type::device_to_host);
+  else
+    internal::copy(data_buffer, data, vecmem::copy::type::device_to_host);
   return data;
 }
 
 template <typename Algorithm,
           typename R = typename Algorithm::intermediate_result_t, typename T,
           typename... Arguments>
-requires vecpar::detail::is_mmap<Algorithm, R, Arguments...> R &
+requires vecpar::detail::is_mmap<Algorithm, R, Arguments...> T &
 parallel_map(Algorithm algorithm,
              __attribute__((unused)) vecmem::host_memory_resource &mr, T &data,
              Arguments &...args) {
@@ -155,6 +178,8 @@ typename R::value_type &parallel_reduce(Algorithm algorithm,
                                         __attribute__((unused))
                                         vecmem::host_memory_resource &mr,
                                         R &data) {
+  static_assert(!vecpar::collection::Any_soa_vector<R>,
+                "soa_vector is supported by the OpenMP backend only");
 
   // copy input data from host to device
   auto data_buffer = internal::copy.to(vecmem::get_data(data), internal::d_mem,
@@ -173,6 +198,8 @@ typename R::value_type &parallel_reduce(Algorithm algorithm,
 template <typename Algorithm, typename R>
 R &parallel_filter(Algorithm algorithm, vecmem::host_memory_resource &mr,
                    R &data) {
+  static_assert(!vecpar::collection::Any_soa_vector<R>,
+                "soa_vector is supported by the OpenMP backend only");
 
   // copy input data from host to device
   auto data_buffer = internal::copy.to(vecmem::get_data(data), internal::d_mem,
@@ -211,6 +238,13 @@ requires vecpar::algorithm::is_map_reduce<Algorithm, Result, R, T, Arguments...>
     Result &
     parallel_map_reduce(Algorithm algorithm, vecmem::host_memory_resource &mr,
                         vecpar::config config, T &data, Arguments &...args) {
+  static_assert(!vecpar::collection::Any_soa_vector<R, T, Arguments...>,
+                "soa_vector is supported by the OpenMP backend only");
+  static_assert(!vecpar::collection::Any_lazy_range<R, T, Arguments...>,
+                "lazy ranges are supported by the OpenMP backend only");
+  static_assert(!vecpar::collection::Any_strided_view<R, T, Arguments...>,
+                "strided views are supported by the OpenMP backend only, the "
+                "CUDA backend copies contiguous storage");
 
   auto fn_jagged = [&]<typename... P>(P & ...obj)
                        ->std::tuple<std::conditional_t<
@@ -282,6 +316,13 @@ requires vecpar::algorithm::is_mmap_reduce<Algorithm, Result, R, Arguments...>
                                 vecmem::host_memory_resource &mr,
                                 vecpar::config config, T &data,
                                 Arguments &...args) {
+  static_assert(!vecpar::collection::Any_soa_vector<R, T, Arguments...>,
+                "soa_vector is supported by the OpenMP backend only");
+  static_assert(!vecpar::collection::Any_lazy_range<R, T, Arguments...>,
+                "lazy ranges are supported by the OpenMP backend only");
+  static_assert(!vecpar::collection::Any_strided_view<R, T, Arguments...>,
+                "strided views are supported by the OpenMP backend only, the "
+                "CUDA backend copies contiguous storage");
   auto fn_jagged =
       [&]<typename... P>(P & ...obj)
           ->std::tuple<std::conditional_t<
@@ -352,6 +393,13 @@ template <class Algorithm, typename R, typename T, typename... Arguments>
 requires vecpar::algorithm::is_map_filter<Algorithm, R, T, Arguments...> R &
 parallel_map_filter(Algorithm algorithm, vecmem::host_memory_resource &mr,
                     vecpar::config config, T &data, Arguments &...args) {
+  static_assert(!vecpar::collection::Any_soa_vector<R, T, Arguments...>,
+                "soa_vector is supported by the OpenMP backend only");
+  static_assert(!vecpar::collection::Any_lazy_range<R, T, Arguments...>,
+                "lazy ranges are supported by the OpenMP backend only");
+  static_assert(!vecpar::collection::Any_strided_view<R, T, Arguments...>,
+                "strided views are supported by the OpenMP backend only, the "
+                "CUDA backend copies contiguous storage");
   size_t size = data.size();
   auto fn_jagged = [&]<typename... P>(P & ...obj)
                        ->std::tuple<std::conditional_t<
@@ -422,6 +470,13 @@ template <class Algorithm, typename R, typename T, typename... Arguments>
 requires vecpar::algorithm::is_mmap_filter<Algorithm, R, Arguments...> R &
 parallel_map_filter(Algorithm algorithm, vecmem::host_memory_resource &mr,
                     vecpar::config config, T &data, Arguments &...args) {
+  static_assert(!vecpar::collection::Any_soa_vector<R, T, Arguments...>,
+                "soa_vector is supported by the OpenMP backend only");
+  static_assert(!vecpar::collection::Any_lazy_range<R, T, Arguments...>,
+                "lazy ranges are supported by the OpenMP backend only");
+  static_assert(!vecpar::collection::Any_strided_view<R, T, Arguments...>,
+                "strided views are supported by the OpenMP backend only, the "
+                "CUDA backend copies contiguous storage");
   size_t size = data.size();
 
   auto fn_jagged =
@@ -2,6 +2,8 @@
 #define VECPAR_CUDA_INTERNAL_HPP
 
 #include <functional>
+#include <tuple>
+#include <utility>
 
 #include <vecmem/containers/data/vector_view.hpp>
 #include <vecmem/containers/device_vector.hpp>
@@ -10,6 +12,7 @@
 #include <vecmem/memory/cuda/device_memory_resource.hpp>
 #include <vecmem/utils/cuda/copy.hpp>
 
+#include "vecpar/core/algorithms/detail/map.hpp"
 #include "vecpar/core/definitions/common.hpp"
 #include "vecpar/core/definitions/config.hpp"
 #include "vecpar/core/definitions/helper.hpp"
@@ -68,6 +71,53 @@ vecmem::data::jagged_vector_view<value_type_t<T>>
 get_view(vecmem::data::jagged_vector_buffer<value_type_t<T>> &coll) {
   return vecmem::get_data(coll);
 }
+
+/// argument of a zip map as passed to the kernel: a view for the
+/// collections, a copy for the other arguments
+template <bool Collection, typename T> auto zip_view(auto &param) {
+  if constexpr (Collection)
+    return get_view<T>(param);
+  else
+    return param;
+}
+
+/// item of an argument of a zip map in the kernel
+template <bool Collection, typename T>
+__device__ decltype(auto) zip_item(int idx, auto &param) {
+  if constexpr (Collection)
+    return get_device_container<T>(param)[idx];
+  else
+    return (param);
+}
+
+/// kernel function of the zip maps. A functor rather than an extended
+/// __device__ lambda: nvcc allows such a lambda only in a function with at
+/// most one parameter pack, which has to come last. The item of the
+/// result (or of the updated collection) comes first, then the items of the
+/// Collections first params and the other params unchanged; Declared holds
+/// the declared types of the params.
+template <typename Algorithm, typename Result, typename Declared,
+          std::size_t Collections>
+struct zip_kernel {
+  Algorithm algorithm;
+
+  template <typename ResultView, typename... Params>
+  __device__ void operator()(int idx, ResultView &d_result,
+                             Params &...d_params) const {
+    call(idx, get_device_container<Result>(d_result),
+         std::index_sequence_for<Params...>{}, d_params...);
+  }
+
+private:
+  template <typename Container, std::size_t... I, typename... Params>
+  __device__ void call(int idx, Container dv_result,
+                       std::index_sequence<I...>, Params &...d_params) const {
+    vecpar::detail::call_mapping_function(
+        algorithm, idx, dv_result[idx],
+        zip_item<(I < Collections), std::tuple_element_t<I, Declared>>(
+            idx, d_params)...);
+  }
+};
 } // namespace helper
 
 namespace internal {
@@ -100,7 +150,7 @@ void parallel_map(vecpar::config c, size_t size, Algorithm algorithm,
         auto dv_data = helper::get_device_container<T>(d_in);
         auto dv_result = helper::get_device_container<R>(d_result);
         //     printf("[mapper] data[%d]=%f\n", idx, dv_data[idx]);
-        algorithm.mapping_function(dv_result[idx], dv_data[idx], a...);
+        vecpar::detail::call_mapping_function(algorithm, idx, dv_result[idx], dv_data[idx], a...);
         //   printf("[mapper] result[%d]=%f\n", idx, dv_result[idx]);
       },
       result_view, data_view, args...);
@@ -136,7 +186,7 @@ void parallel_map(vecpar::config c, size_t size, Algorithm algorithm,
         auto dv_data_2 = helper::get_device_container<T2>(d_in_2);
         auto dv_result = helper::get_device_container<R>(d_result);
         //     printf("[mapper] data[%d]=%f\n", idx, dv_data[idx]);
-        algorithm.mapping_function(dv_result[idx], dv_data_1[idx], dv_data_2[idx], a...);
+        vecpar::detail::call_mapping_function(algorithm, idx, dv_result[idx], dv_data_1[idx], dv_data_2[idx], a...);
         //   printf("[mapper] result[%d]=%f\n", idx, dv_result[idx]);
       },
       result_view, in_1_view, in_2_view, args...);
@@ -174,7 +224,7 @@ void parallel_map(vecpar::config c, size_t size, Algorithm algorithm,
         auto dv_data_3 = helper::get_device_container<T3>(d_in_3);
         auto dv_result = helper::get_device_container<R>(d_result);
         //       printf("[mapper] data[%d]=%f\n", idx, dv_data_3[idx]);
-        algorithm.mapping_function(dv_result[idx], dv_data_1[idx], dv_data_2[idx],
+        vecpar::detail::call_mapping_function(algorithm, idx, dv_result[idx], dv_data_1[idx], dv_data_2[idx],
                                    dv_data_3[idx], a...);
         //   printf("[mapper] result[%d]=%f\n", idx, dv_result[idx]);
       },
@@ -216,7 +266,7 @@ void parallel_map(vecpar::config c, size_t size, Algorithm algorithm,
         auto dv_data_4 = helper::get_device_container<T4>(d_in_4);
         auto dv_result = helper::get_device_container<R>(d_result);
         //     printf("[mapper] data[%d]=%f\n", idx, dv_data[idx]);
-        algorithm.mapping_function(dv_result[idx], dv_data_1[idx], dv_data_2[idx],
+        vecpar::detail::call_mapping_function(algorithm, idx, dv_result[idx], dv_data_1[idx], dv_data_2[idx],
                                    dv_data_3[idx], dv_data_4[idx], a...);
         //   printf("[mapper] result[%d]=%f\n", idx, dv_result[idx]);
       },
@@ -262,7 +312,7 @@ void parallel_map(vecpar::config c, size_t size, Algorithm algorithm,
         auto dv_data_5 = helper::get_device_container<T5>(d_in_5);
         auto dv_result = helper::get_device_container<R>(d_result);
         //     printf("[mapper] data[%d]=%f\n", idx, dv_data[idx]);
-        algorithm.mapping_function(dv_result[idx], dv_data_1[idx], dv_data_2[idx],
+        vecpar::detail::call_mapping_function(algorithm, idx, dv_result[idx], dv_data_1[idx], dv_data_2[idx],
                                    dv_data_3[idx], dv_data_4[idx], dv_data_5[idx], a...);
         //   printf("[mapper] result[%d]=%f\n", idx, dv_result[idx]);
       },
@@ -273,6 +323,43 @@ void parallel_map(vecpar::config c, size_t size, Algorithm algorithm,
   CHECK_ERROR(cudaDeviceSynchronize())
 }
 
+/// any number of collections (Algorithm::input_count), all read in the same
+/// kernel; All are the declared types of the params
+template <typename Algorithm, typename R = typename Algorithm::result_t,
+          typename... All>
+requires vecpar::detail::is_zip_map<Algorithm, R, All...>
+void parallel_map(vecpar::config c, size_t size, Algorithm algorithm,
+                  auto &result, auto &...params) {
+  constexpr std::size_t N = Algorithm::input_count;
+  using declared = std::tuple<All...>;
+
+  // make sure that an empty config doesn't end up to be used
+  if (vecpar::config::isEmpty(c)) {
+    c = vecpar::cuda::getDefaultConfig(size);
+  }
+
+  DEBUG_ACTION(printf("[MAP] nBlocks:%d, nThreads:%d, memorySize:%zu\n",
+                      c.m_gridSize, c.m_blockSize, c.m_memorySize);)
+
+  auto result_view = helper::get_view<R>(result);
+  auto views = [&]<std::size_t... I>(std::index_sequence<I...>) {
+    return std::make_tuple(
+        helper::zip_view<(I < N), std::tuple_element_t<I, declared>>(
+            params)...);
+  }(std::index_sequence_for<All...>{});
+
+  std::apply(
+      [&](auto &...v) {
+        vecpar::cuda::kernel<<<c.m_gridSize, c.m_blockSize, c.m_memorySize>>>(
+            size, helper::zip_kernel<Algorithm, R, declared, N>{algorithm},
+            result_view, v...);
+      },
+      views);
+
+  CHECK_ERROR(cudaGetLastError())
+  CHECK_ERROR(cudaDeviceSynchronize())
+}
+
 template <typename Algorithm, typename TT, typename... Arguments>
 requires vecpar::detail::is_mmap_1<Algorithm, TT, Arguments...>
 void parallel_mmap(vecpar::config c, size_t size, const Algorithm algorithm,
@@ -295,7 +382,7 @@ void parallel_mmap(vecpar::config c, size_t size, const Algorithm algorithm,
             [algorithm] __device__(int idx, auto &d_in_out_view, Arguments... a) {
                 auto dv_data = helper::get_device_container<TT>(d_in_out_view);
                 //   printf("[mapper] data[%d]=%f\n", idx, dv_data[idx]);
-        algorithm.mapping_function(dv_data[idx], a...);
+        vecpar::detail::call_mapping_function(algorithm, idx, dv_data[idx], a...);
                 //     printf("[mapper] result[%d]=%f\n", idx, dv_data[idx]);
             },
             input_output_view, args...);
@@ -326,7 +413,7 @@ void parallel_mmap(vecpar::config c, size_t size, Algorithm algorithm,
                              Arguments... a) {
         auto dv_data_1 = helper::get_device_container<T1>(d_in_out);
         auto dv_data_2 = helper::get_device_container<T2>(d_in_2);
-        algorithm.mapping_function(dv_data_1[idx], dv_data_2[idx], a...);
+        vecpar::detail::call_mapping_function(algorithm, idx, dv_data_1[idx], dv_data_2[idx], a...);
       },
       input_output_view, in_2_view, args...);
 
@@ -361,7 +448,7 @@ void parallel_mmap(vecpar::config c, size_t size, Algorithm algorithm,
         auto dv_data_2 = helper::get_device_container<T2>(d_in_2);
         auto dv_data_3 = helper::get_device_container<T3>(d_in_3);
 
-        algorithm.mapping_function(dv_data_1[idx], dv_data_2[idx], dv_data_3[idx], a...);
+        vecpar::detail::call_mapping_function(algorithm, idx, dv_data_1[idx], dv_data_2[idx], dv_data_3[idx], a...);
       },
       input_output_view, in_2_view, in_3_view, args...);
 
@@ -399,7 +486,7 @@ void parallel_mmap(vecpar::config c, size_t size, Algorithm algorithm,
         auto dv_data_3 = helper::get_device_container<T3>(d_in_3);
         auto dv_data_4 = helper::get_device_container<T4>(d_in_4);
 
-        algorithm.mapping_function(dv_data_1[idx], dv_data_2[idx], dv_data_3[idx],
+        vecpar::detail::call_mapping_function(algorithm, idx, dv_data_1[idx], dv_data_2[idx], dv_data_3[idx],
                                    dv_data_4[idx], a...);
       },
       input_output_view, in_2_view, in_3_view, in_4_view, args...);
@@ -440,7 +527,7 @@ void parallel_mmap(vecpar::config c, size_t size, Algorithm algorithm,
         auto dv_data_4 = helper::get_device_container<T4>(view_4);
         auto dv_data_5 = helper::get_device_container<T5>(view_5);
 
-        algorithm.mapping_function(dv_data_1[idx], dv_data_2[idx], dv_data_3[idx],
+        vecpar::detail::call_mapping_function(algorithm, idx, dv_data_1[idx], dv_data_2[idx], dv_data_3[idx],
                                    dv_data_4[idx], dv_data_5[idx], a...);
       },
       input_output_view, in_2_view, in_3_view, in_4_view, in_5_view, args...);
@@ -449,6 +536,43 @@ void parallel_mmap(vecpar::config c, size_t size, Algorithm algorithm,
   CHECK_ERROR(cudaDeviceSynchronize())
 }
 
+/// any number of collections (Algorithm::input_count), the first one being
+/// updated; All are the declared types of the params after it
+template <typename Algorithm, typename TT, typename... All>
+requires vecpar::detail::is_zip_mmap<Algorithm, TT, All...>
+void parallel_mmap(vecpar::config c, size_t size, Algorithm algorithm,
+                   auto &input_output, auto &...params) {
+  constexpr std::size_t N = Algorithm::input_count;
+  using declared = std::tuple<All...>;
+
+  // make sure that an empty config doesn't end up to be used
+  if (vecpar::config::isEmpty(c)) {
+    c = vecpar::cuda::getDefaultConfig(size);
+  }
+
+  DEBUG_ACTION(printf("[MAP] nBlocks:%d, nThreads:%d, memorySize:%zu\n",
+                      c.m_gridSize, c.m_blockSize, c.m_memorySize);)
+
+  auto input_output_view = helper::get_view<TT>(input_output);
+  auto views = [&]<std::size_t... I>(std::index_sequence<I...>) {
+    return std::make_tuple(
+        helper::zip_view<(I + 1 < N), std::tuple_element_t<I, declared>>(
+            params)...);
+  }(std::index_sequence_for<All...>{});
+
+  std::apply(
+      [&](auto &...v) {
+        vecpar::cuda::kernel<<<c.m_gridSize, c.m_blockSize, c.m_memorySize>>>(
+            size,
+            helper::zip_kernel<Algorithm, TT, declared, N - 1>{algorithm},
+            input_output_view, v...);
+      },
+      views);
+
+  CHECK_ERROR(cudaGetLastError())
+  CHECK_ERROR(cudaDeviceSynchronize())
+}
+
 /// based on
 /// https://developer.download.nvidia.com/assets/cuda/files/reduction.pdf more
 /// efficient versions using thread-block parametrization can be implemented
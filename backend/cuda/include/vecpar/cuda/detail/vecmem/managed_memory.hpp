@@ -15,6 +15,13 @@ template <typename Algorithm,
 requires vecpar::detail::is_map<Algorithm, R, T, Arguments...> R &
 parallel_map(Algorithm algorithm, vecmem::cuda::managed_memory_resource &mr,
              vecpar::config config, T &in_1, Arguments &...args) {
+  static_assert(!vecpar::collection::Any_soa_vector<R, T, Arguments...>,
+                "soa_vector is supported by the OpenMP backend only");
+  static_assert(!vecpar::collection::Any_lazy_range<R, T, Arguments...>,
+                "lazy ranges are supported by the OpenMP backend only");
+  static_assert(!vecpar::collection::Any_strided_view<R, T, Arguments...>,
+                "strided views are supported by the OpenMP backend only, the "
+                "CUDA backend copies contiguous storage");
 
   R *map_result = new R(in_1.size(), &mr);
   auto map_view = vecmem::get_data(*map_result);
@@ -45,10 +52,17 @@ parallel_map(Algorithm algorithm, vecmem::cuda::managed_memory_resource &mr,
 template <typename Algorithm,
           typename R = typename Algorithm::intermediate_result_t, typename T,
           typename... Arguments>
-requires vecpar::detail::is_mmap<Algorithm, T, Arguments...> R &
+requires vecpar::detail::is_mmap<Algorithm, T, Arguments...> T &
 parallel_map(Algorithm algorithm,
              __attribute__((unused)) vecmem::cuda::managed_memory_resource &mr,
              vecpar::config config, T &in_out_1, Arguments &...args) {
+  static_assert(!vecpar::collection::Any_soa_vector<R, T, Arguments...>,
+                "soa_vector is supported by the OpenMP backend only");
+  static_assert(!vecpar::collection::Any_lazy_range<R, T, Arguments...>,
+                "lazy ranges are supported by the OpenMP backend only");
+  static_assert(!vecpar::collection::Any_strided_view<R, T, Arguments...>,
+                "strided views are supported by the OpenMP backend only, the "
+                "CUDA backend copies contiguous storage");
 
   auto input = get_view_or_obj(in_out_1, args...);
 
@@ -66,7 +80,7 @@ parallel_map(Algorithm algorithm,
 template <typename Algorithm,
           typename R = typename Algorithm::intermediate_result_t, typename T,
           typename... Arguments>
-requires vecpar::detail::is_mmap<Algorithm, R, Arguments...> R &
+requires vecpar::detail::is_mmap<Algorithm, R, Arguments...> T &
 parallel_map(Algorithm algorithm,
              __attribute__((unused)) vecmem::cuda::managed_memory_resource &mr,
              T &data, Arguments &...args) {
@@ -80,6 +94,8 @@ parallel_reduce(Algorithm algorithm,
                 __attribute__((unused))
                 vecmem::cuda::managed_memory_resource &mr,
                 T &data) {
+  static_assert(!vecpar::collection::Any_soa_vector<T>,
+                "soa_vector is supported by the OpenMP backend only");
 
   typename T::value_type *d_result;
   cudaMallocManaged(&d_result, sizeof(typename T::value_type));
@@ -94,6 +110,8 @@ parallel_reduce(Algorithm algorithm,
 template <typename Algorithm, typename T>
 T &parallel_filter(Algorithm algorithm,
                    vecmem::cuda::managed_memory_resource &mr, T &data) {
+  static_assert(!vecpar::collection::Any_soa_vector<T>,
+                "soa_vector is supported by the OpenMP backend only");
   T *result = new T(data.size(), &mr);
   auto result_view = vecmem::get_data(*result);
 
@@ -3,9 +3,62 @@
 
 #include "config.hpp"
 #include <omp.h>
+#if __has_include(<unistd.h>)
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include <vecmem/containers/vector.hpp>
+#include <vecmem/memory/memory_resource.hpp>
+
+#include "vecpar/core/algorithms/detail/map.hpp"
+#include "vecpar/core/algorithms/reducers.hpp"
+#include "vecpar/core/definitions/csr.hpp"
+#include "vecpar/core/definitions/helper.hpp"
+#include "vecpar/core/definitions/scratch.hpp"
+#include "vecpar/core/definitions/selection.hpp"
 
 namespace internal {
 
+/// number of threads requested by the config or the OMP runtime default
+static inline int get_num_threads(vecpar::config config) {
+  if (vecpar::config::isEmpty(config))
+    return omp_get_max_threads();
+  return config.m_gridSize * config.m_blockSize;
+}
+
+/// first index of the contiguous chunk owned by thread tid out of nthreads
+static inline std::size_t chunk_begin(std::size_t size, int tid,
+                                      int nthreads) {
+  return size * tid / nthreads;
+}
+
+/// whether any of the inputs, taken by forwarding reference, is a temporary
+/// (e.g. a lazy range created in the call); a temporary config is not
+/// counted since the overloads taking the inputs by reference accept it
+template <typename... Inputs>
+concept has_temporary =
+    ((!std::is_lvalue_reference_v<Inputs> &&
+      !std::same_as<std::remove_cvref_t<Inputs>, vecpar::config>) ||
+     ...);
+
 template <typename Function, typename... Arguments>
 void offload_map(vecpar::config config, int size, Function f,
                  Arguments &...args) {
@@ -26,11 +79,506 @@ void offload_map(vecpar::config config, int size, Function f,
   DEBUG_ACTION(printf("Using %d OpenMP threads \n", threadsNum);)
 }
 
+/// range [first, last) of [0, size) owned by thread tid out of nthreads when
+/// the ranges of the threads start at multiples of grain
+static inline std::pair<std::size_t, std::size_t>
+grain_chunk(std::size_t size, std::size_t grain, int tid, int nthreads) {
+  const std::size_t blocks = (size + grain - 1) / grain;
+  return {std::min(size, chunk_begin(blocks, tid, nthreads) * grain),
+          std::min(size, chunk_begin(blocks, tid + 1, nthreads) * grain)};
+}
+
+/// number of items of the collection per cache line when its storage
+/// starts at a cache line (e.g. allocated by vecpar::aligned_memory_resource),
+/// 1 otherwise
+template <typename C> std::size_t cache_line_grain(C &collection) {
+  if constexpr (requires { collection.data(); }) {
+    using item_t = std::remove_cvref_t<decltype(*collection.data())>;
+    constexpr std::size_t line = 64;
+    if (line % sizeof(item_t) == 0 &&
+        reinterpret_cast<std::uintptr_t>(collection.data()) % line == 0)
+      return line / sizeof(item_t);
+  }
+  return 1;
+}
+
+/// like offload_map, but every thread owns config.m_memorySize bytes of
+/// aligned scratch for the whole parallel region, passed as f(i, scratch);
+/// the thread_init/thread_finalize hooks of the algorithm run once per
+/// thread around its iterations. With grain > 1 the contiguous range of
+/// every thread starts at a multiple of grain: for a cache-line aligned
+/// result (see cache_line_grain) the threads never write to the same line
+/// and their vectorized loops start at aligned addresses.
+template <typename Algorithm, typename Function>
+void offload_map_scratch(vecpar::config config, int size,
+                         Algorithm &algorithm, Function f,
+                         std::size_t grain = 1) {
+  const int threads = get_num_threads(config);
+  const vecpar::detail::scratch_pool pool(config, threads);
+#pragma omp parallel num_threads(threads)
+  {
+    vecpar::detail::thread_scratch<Algorithm> s(algorithm, pool,
+                                                omp_get_thread_num());
+    if (grain == 1) {
+#pragma omp for
+      for (int i = 0; i < size; i++)
+        f(i, s.get());
+    } else {
+      const auto [first, last] = grain_chunk(
+          size, grain, omp_get_thread_num(), omp_get_num_threads());
+      const int end = static_cast<int>(last);
+      for (int i = static_cast<int>(first); i < end; i++)
+        f(i, s.get());
+    }
+  }
+}
+
+/// vecmem vectors of trivially copyable items, accessed by offload_map_aligned
+/// through a pointer to their storage
+template <typename C>
+concept is_plain_vector =
+    vecpar::collection::Vector_type<std::remove_const_t<C>> &&
+    std::is_trivially_copyable_v<typename C::value_type>;
+
+/// whether the first N of Args are plain vectors
+template <std::size_t N, typename... Args>
+constexpr bool leading_plain_vectors = N == 0;
+
+template <std::size_t N, typename First, typename... Rest>
+requires(N > 0) constexpr bool leading_plain_vectors<N, First, Rest...> =
+    is_plain_vector<First> && leading_plain_vectors<N - 1, Rest...>;
+
+/// type of the item passed to the mapping function for an argument
+template <typename C> using item_t = decltype(get(0, std::declval<C &>()));
+
+/// mapping functions which use neither the scratch nor the thread hooks, so
+/// that their iterations are independent
+template <typename Algorithm, typename... Items>
+concept has_independent_items =
+    !vecpar::detail::has_thread_init<Algorithm> &&
+    !vecpar::detail::has_thread_finalize<Algorithm> &&
+    !vecpar::detail::has_scratch_mapping<Algorithm, Items...> &&
+    !vecpar::detail::has_indexed_mapping<Algorithm, vecpar::scratch &,
+                                         Items...>;
+
+/// maps whose collections (the result and the Algorithm::input_count
+/// leading inputs) are plain vectors; the other arguments, e.g. a scalar,
+/// are passed through unchanged
+template <typename Algorithm, typename R, typename T, typename... Rest>
+concept is_aligned_map =
+    is_plain_vector<R> && is_plain_vector<T> &&
+    leading_plain_vectors<Algorithm::input_count - 1, Rest...> &&
+    has_independent_items<Algorithm, typename R::value_type &,
+                          typename T::value_type &, item_t<Rest>...>;
+
+/// the same for an mmap, which updates T in place
+template <typename Algorithm, typename T, typename... Rest>
+concept is_aligned_mmap =
+    is_plain_vector<T> &&
+    leading_plain_vectors<Algorithm::input_count - 1, Rest...> &&
+    has_independent_items<Algorithm, typename T::value_type &,
+                          item_t<Rest>...>;
+
+/// whether the storage of the first Collections arguments starts at a cache
+/// line
+template <std::size_t Collections, typename... Args>
+bool cache_line_aligned(Args &...args) {
+  const auto refs = std::forward_as_tuple(args...);
+  return [&]<std::size_t... I>(std::index_sequence<I...>) {
+    return ((reinterpret_cast<std::uintptr_t>(std::get<I>(refs).data()) % 64 ==
+             0) &&
+            ...);
+  }(std::make_index_sequence<Collections>{});
+}
+
+/// smallest number of items after which all the collections are again at
+/// the start of a cache line
+template <typename... Collections>
+constexpr std::size_t common_cache_line_grain() {
+  return std::max<std::size_t>(
+      {1, 64 / std::gcd(std::size_t(64),
+                        sizeof(typename Collections::value_type))...});
+}
+
+/// pointer to the storage of a collection which starts at a cache line
+template <typename C> auto *aligned_data(C &collection) {
+  return static_cast<decltype(collection.data())>(
+      __builtin_assume_aligned(collection.data(), 64));
+}
+
+/// argument of offload_map_aligned which is not a collection
+template <typename C> struct passed_through { C &arg; };
+
+/// an aligned pointer to the storage of a collection, the argument itself
+/// wrapped otherwise
+template <bool Collection, typename C> auto aligned_arg(C &arg) {
+  if constexpr (Collection)
+    return aligned_data(arg);
+  else
+    return passed_through<C>{arg};
+}
+
+template <typename V> V &aligned_item(V *data, std::size_t i) {
+  return data[i];
+}
+
+template <typename C>
+C &aligned_item(passed_through<C> p, __attribute__((unused)) std::size_t i) {
+  return p.arg;
+}
+
+/// map (or mmap, with InPlace) over collections which all start at a cache
+/// line (see cache_line_aligned): every thread owns a range starting at a
+/// multiple of grain items, i.e. at a cache line of all the collections,
+/// and runs it as a simd loop over pointers declared aligned, so that the
+/// vectorized loop uses aligned loads and stores and needs no peeling.
+/// Only the first Algorithm::input_count - 1 of rest are collections.
+template <bool InPlace, typename Algorithm, typename R, typename T,
+          typename... Rest>
+void offload_map_aligned(vecpar::config config, Algorithm &algorithm,
+                         R &result, T &data, Rest &...rest) {
+  constexpr std::size_t collections = Algorithm::input_count - 1;
+  const std::size_t size = data.size();
+  auto *out = aligned_data(result);
+  auto *in = aligned_data(data);
+  constexpr std::size_t grain = []<std::size_t... I>(std::index_sequence<I...>) {
+    return common_cache_line_grain<
+        R, T, std::tuple_element_t<I, std::tuple<Rest...>>...>();
+  }(std::make_index_sequence<collections>{});
+  const auto args = [&]<std::size_t... I>(std::index_sequence<I...>) {
+    return std::make_tuple(aligned_arg<(I < collections)>(rest)...);
+  }(std::index_sequence_for<Rest...>{});
+
+#pragma omp parallel num_threads(get_num_threads(config))
+  {
+    const auto chunk = grain_chunk(size, grain, omp_get_thread_num(),
+                                   omp_get_num_threads());
+    std::apply(
+        [&, first = chunk.first, last = chunk.second](auto... a) {
+#pragma omp simd
+          for (std::size_t i = first; i < last; i++) {
+            if constexpr (InPlace)
+              vecpar::detail::call_mapping_function(algorithm, i, in[i],
+                                                    aligned_item(a, i)...);
+            else
+              vecpar::detail::call_mapping_function(
+                  algorithm, i, out[i], in[i], aligned_item(a, i)...);
+          }
+        },
+        args);
+  }
+}
+
+/// items per block converted at once by offload_map_staged
+constexpr std::size_t staged_block_size = 256;
+
+/// access to an argument of a map over a block of items: collections of a
+/// reduced-precision type (see reduced_precision.hpp) are widened into a
+/// float buffer (and narrowed back by store), all other arguments are
+/// accessed directly
+template <typename C> class staged {
+public:
+  static constexpr bool widened = [] {
+    if constexpr (vecpar::collection::Vector_type<C> ||
+                  vecpar::collection::View_type<C>)
+      return vecpar::Reduced_precision_type<typename C::value_type>;
+    else
+      return false;
+  }();
+
+  explicit staged(C &c) : m_c(c) {}
+
+  void load(std::size_t first, std::size_t n) {
+    m_first = first;
+    if constexpr (widened) {
+      if constexpr (requires { m_c.data(); })
+        vecpar::widen(m_c.data() + first, m_buffer, n);
+      else
+        for (std::size_t k = 0; k < n; k++)
+          m_buffer[k] = m_c[first + k];
+    }
+  }
+
+  void store(std::size_t first, std::size_t n) {
+    if constexpr (widened) {
+      if constexpr (requires { m_c.data(); })
+        vecpar::narrow(m_buffer, m_c.data() + first, n);
+      else
+        for (std::size_t k = 0; k < n; k++)
+          m_c[first + k] = m_buffer[k];
+    }
+  }
+
+  decltype(auto) operator[](std::size_t k) {
+    if constexpr (widened)
+      return (m_buffer[k]);
+    else
+      return get(static_cast<int>(m_first + k), m_c);
+  }
+
+private:
+  C &m_c;
+  std::size_t m_first = 0;
+  float m_buffer[widened ? staged_block_size : 1];
+};
+
+/// map (or mmap, with InPlace) whose reduced-precision collections are
+/// converted block by block: every thread widens a block of the inputs
+/// into float buffers, calls the mapping function on the buffers and
+/// narrows the outputs back, so that the conversions are done with vector
+/// instructions and the mapping function can be vectorized on floats
+template <bool InPlace, typename Algorithm, typename R, typename T,
+          typename... Rest>
+void offload_map_staged(vecpar::config config, Algorithm &algorithm,
+                        R &result, T &data, Rest &...rest) {
+  const std::size_t size = data.size();
+  const std::size_t blocks =
+      (size + staged_block_size - 1) / staged_block_size;
+
+  const int threads = get_num_threads(config);
+  const vecpar::detail::scratch_pool pool(config, threads);
+#pragma omp parallel num_threads(threads)
+  {
+    vecpar::detail::thread_scratch<Algorithm> s(algorithm, pool,
+                                                omp_get_thread_num());
+    staged<R> out(result);
+    staged<T> in(data);
+    std::tuple<staged<Rest>...> args(rest...);
+
+#pragma omp for
+    for (std::size_t b = 0; b < blocks; b++) {
+      const std::size_t first = b * staged_block_size;
+      const std::size_t n = std::min(staged_block_size, size - first);
+      in.load(first, n);
+      std::apply([&](auto &...a) { (a.load(first, n), ...); }, args);
+
+      std::apply(
+          [&](auto &...a) {
+            for (std::size_t k = 0; k < n; k++) {
+              if constexpr (InPlace)
+                vecpar::detail::call_mapping_function(algorithm, first + k,
+                                                      s.get(), in[k], a[k]...);
+              else
+                vecpar::detail::call_mapping_function(
+                    algorithm, first + k, s.get(), out[k], in[k], a[k]...);
+            }
+          },
+          args);
+
+      if constexpr (InPlace)
+        in.store(first, n);
+      else
+        out.store(first, n);
+    }
+  }
+}
+
+/// the items of Out are stored in a reduced-precision type and the mapping
+/// function computes them in float (see offload_map_staged)
+template <typename Algorithm, typename Out, typename... Collections>
+concept is_staged_map = vecpar::detail::has_widened_mapping<
+    Algorithm, typename Out::value_type &,
+    decltype(get(0, std::declval<Collections &>()))...>;
+
+/// bytes of results computed into a thread buffer before they are streamed
+constexpr std::size_t streaming_block_bytes = 4096;
+
+/// output size from which maps use streaming stores with
+/// store_hint::automatic: the size of the last-level cache if the system
+/// reports it, 32 MiB otherwise
+static inline std::size_t streaming_store_threshold() {
+  static const std::size_t threshold = [] {
+    long bytes = -1;
+#if defined(_SC_LEVEL3_CACHE_SIZE)
+    bytes = sysconf(_SC_LEVEL3_CACHE_SIZE);
+#endif
+    return bytes > 0 ? static_cast<std::size_t>(bytes)
+                     : std::size_t(32) << 20;
+  }();
+  return threshold;
+}
+
+/// copies bytes to dst with non-temporal stores for the 64-byte aligned
+/// lines of the destination (regular stores for the partial lines at both
+/// ends); the caller issues an sfence before the results are read
+static inline void stream_bytes(void *dst, const void *src,
+                                std::size_t bytes) {
+  char *d = static_cast<char *>(dst);
+  const char *s = static_cast<const char *>(src);
+#if defined(__SSE2__)
+  const std::size_t head = std::min(
+      bytes, (64 - reinterpret_cast<std::uintptr_t>(d) % 64) % 64);
+  std::memcpy(d, s, head);
+  std::size_t i = head;
+  for (; i + 64 <= bytes; i += 64) {
+#if defined(__AVX512F__)
+    _mm512_stream_si512(reinterpret_cast<__m512i *>(d + i),
+                        _mm512_loadu_si512(s + i));
+#elif defined(__AVX__)
+    for (std::size_t k = 0; k < 64; k += 32)
+      _mm256_stream_si256(
+          reinterpret_cast<__m256i *>(d + i + k),
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i + k)));
+#else
+    for (std::size_t k = 0; k < 64; k += 16)
+      _mm_stream_si128(
+          reinterpret_cast<__m128i *>(d + i + k),
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i + k)));
+#endif
+  }
+  std::memcpy(d + i, s + i, bytes - i);
+#else
+  std::memcpy(d, s, bytes);
+#endif
+}
+
+static inline void stream_fence() {
+#if defined(__SSE2__)
+  _mm_sfence();
+#endif
+}
+
+/// map whose results are computed block by block into a buffer of the
+/// thread and then written to the result with streaming stores, so that
+/// the result does not evict the inputs from the caches and its lines are
+/// not read before being overwritten
+template <typename Algorithm, typename R, typename T, typename... Rest>
+void offload_map_streaming(vecpar::config config, Algorithm &algorithm,
+                           R &result, T &data, Rest &...rest) {
+  using item_t = std::remove_cvref_t<decltype(result[0])>;
+  const std::size_t size = data.size();
+  const std::size_t block =
+      std::max<std::size_t>(1, streaming_block_bytes / sizeof(item_t));
+  const std::size_t blocks = (size + block - 1) / block;
+
+  const int threads = get_num_threads(config);
+  const vecpar::detail::scratch_pool pool(config, threads);
+  std::vector<item_t> buffers(block * threads);
+#pragma omp parallel num_threads(threads)
+  {
+    vecpar::detail::thread_scratch<Algorithm> s(algorithm, pool,
+                                                omp_get_thread_num());
+    item_t *buffer = buffers.data() + block * omp_get_thread_num();
+
+#pragma omp for schedule(static)
+    for (std::size_t b = 0; b < blocks; b++) {
+      const std::size_t first = b * block;
+      const std::size_t n = std::min(block, size - first);
+      for (std::size_t k = 0; k < n; k++) {
+        const int idx = static_cast<int>(first + k);
+        vecpar::detail::call_mapping_function(algorithm, idx, s.get(),
+                                              buffer[k], data[idx],
+                                              get(idx, rest)...);
+      }
+      stream_bytes(result.data() + first, buffer, n * sizeof(item_t));
+    }
+    stream_fence();
+  }
+}
+
+/// results which can be written with streaming stores
+template <typename R>
+concept is_streamable_result = requires(R &r) {
+  r.data();
+} && std::is_trivially_copyable_v<
+    std::remove_cvref_t<decltype(std::declval<R &>()[0])>>;
+
+/// streaming stores are used when the config asks for them or, with
+/// store_hint::automatic, when the result exceeds the last-level cache and
+/// several threads write it (a single thread does not saturate the memory
+/// bandwidth, so saving the read-for-ownership traffic does not outweigh
+/// the extra copy)
+static inline bool use_streaming_stores(vecpar::config config,
+                                        std::size_t bytes) {
+  switch (config.m_storeHint) {
+  case vecpar::store_hint::streaming:
+    return true;
+  case vecpar::store_hint::regular:
+    return false;
+  default:
+    return bytes >= streaming_store_threshold() &&
+           get_num_threads(config) > 1;
+  }
+}
+
+/// out[i] = value(i) for i in [0, size), split between the threads as the
+/// results of a map (see offload_map_scratch), so that every thread first
+/// touches the pages it processes later. Large outputs are written with
+/// streaming stores under the same conditions as map results.
+template <typename C, typename Value>
+void offload_write(vecpar::config config, C &out, std::size_t size,
+                   Value value) {
+  using item_t = std::remove_cvref_t<decltype(out[0])>;
+  if constexpr (is_streamable_result<C>) {
+    if (use_streaming_stores(config, size * sizeof(item_t))) {
+      const std::size_t block =
+          std::max<std::size_t>(1, streaming_block_bytes / sizeof(item_t));
+      const std::size_t blocks = (size + block - 1) / block;
+      const int threads = get_num_threads(config);
+      std::vector<item_t> buffers(block * threads);
+#pragma omp parallel num_threads(threads)
+      {
+        item_t *buffer = buffers.data() + block * omp_get_thread_num();
+#pragma omp for schedule(static)
+        for (std::size_t b = 0; b < blocks; b++) {
+          const std::size_t first = b * block;
+          const std::size_t n = std::min(block, size - first);
+          for (std::size_t k = 0; k < n; k++)
+            buffer[k] = value(first + k);
+          stream_bytes(out.data() + first, buffer, n * sizeof(item_t));
+        }
+        stream_fence();
+      }
+      return;
+    }
+  }
+  const std::size_t grain = cache_line_grain(out);
+#pragma omp parallel num_threads(get_num_threads(config))
+  {
+    const auto [first, last] = grain_chunk(
+        size, grain, omp_get_thread_num(), omp_get_num_threads());
+    for (std::size_t i = first; i < last; i++)
+      out[i] = value(i);
+  }
+}
+
+/// writes a byte in every page of the storage of size items of item_bytes
+/// at p, from the thread which owns the items of the page in offload_write,
+/// so that the operating system allocates the pages close to that thread
+static inline void first_touch(vecpar::config config, void *p,
+                               std::size_t size, std::size_t item_bytes,
+                               std::size_t grain) {
+  long page_size = -1;
+#if defined(_SC_PAGESIZE)
+  page_size = sysconf(_SC_PAGESIZE);
+#endif
+  const std::size_t page = page_size > 0 ? page_size : 4096;
+  char *bytes = static_cast<char *>(p);
+#pragma omp parallel num_threads(get_num_threads(config))
+  {
+    const auto [first, last] = grain_chunk(
+        size, grain, omp_get_thread_num(), omp_get_num_threads());
+    for (std::size_t b = first * item_bytes; b < last * item_bytes;
+         b = (b / page + 1) * page)
+      bytes[b] = 0;
+  }
+}
+
+/// resizes an empty vector to size items: its storage is reserved and
+/// first touched by the threads which own its items in offload_write
+/// before the items are constructed
+template <typename T>
+void first_touch_resize(vecpar::config config, vecmem::vector<T> &v,
+                        std::size_t size) {
+  v.reserve(size);
+  first_touch(config, v.data(), size, sizeof(T), cache_line_grain(v));
+  v.resize(size);
+}
+
 /// based on article:
 /// https://coderwall.com/p/gocbhg/openmp-improve-reduction-techniques
-template <typename R, typename Function>
-void offload_reduce(int size, R *result, Function f,
-                    vecmem::vector<R> &map_result) {
+template <typename R, typename Function, typename Collection>
+void offload_reduce(int size, R *result, Function f, Collection &map_result) {
 #pragma omp parallel
   {
     R *tmp_result = new R();
@@ -53,5 +601,822 @@ void offload_filter(int size, R *result, Function f) {
   }
   result->resize(idx);
 }
+
+/// reduction with an explicit accumulator: every thread accumulates its own
+/// contiguous chunk of [0, size) starting from the identity and the
+/// per-thread partials are combined in thread order, so the result does not
+/// depend on the scheduling. With Lanes > 1 every thread keeps Lanes
+/// independent accumulators (consecutive elements go to consecutive lanes)
+/// which the compiler can map to SIMD lanes.
+template <std::size_t Lanes = 1, typename Acc, typename Accumulate,
+          typename Combine>
+Acc offload_accumulate(vecpar::config config, std::size_t size,
+                       const Acc &identity, Accumulate accumulate,
+                       Combine combine) {
+  const int max_threads = get_num_threads(config);
+  std::vector<Acc> partials(max_threads, identity);
+
+#pragma omp parallel num_threads(max_threads)
+  {
+    const int tid = omp_get_thread_num();
+    const int nthreads = omp_get_num_threads();
+
+    std::size_t i = chunk_begin(size, tid, nthreads);
+    const std::size_t end = chunk_begin(size, tid + 1, nthreads);
+
+    Acc local = identity;
+    if constexpr (Lanes > 1) {
+      Acc lane[Lanes];
+      for (std::size_t l = 0; l < Lanes; l++)
+        lane[l] = identity;
+      for (; i + Lanes <= end; i += Lanes) {
+#pragma omp simd
+        for (std::size_t l = 0; l < Lanes; l++)
+          accumulate(lane[l], i + l);
+      }
+      for (std::size_t l = 0; l < Lanes; l++)
+        combine(local, lane[l]);
+    }
+    for (; i < end; i++)
+      accumulate(local, i);
+    partials[tid] = local;
+  }
+
+  Acc result = identity;
+  for (const Acc &partial : partials)
+    combine(result, partial);
+  return result;
+}
+
+/// number of consecutive elements scanned between two checks of the early
+/// exit condition of a search
+constexpr std::size_t search_block_size = 1024;
+
+/// lowest i for which pred(i) holds, or size if there is none. The blocks are
+/// dealt round-robin to the threads, so that the lower indices are scanned
+/// first; a thread stops at its first match or as soon as its next block
+/// starts after a match already found by another thread.
+template <typename Predicate>
+std::size_t offload_find_first(vecpar::config config, std::size_t size,
+                               Predicate pred) {
+  std::atomic<std::size_t> first{size};
+  const std::size_t blocks =
+      (size + search_block_size - 1) / search_block_size;
+
+#pragma omp parallel num_threads(get_num_threads(config))
+  {
+    const std::size_t nthreads = omp_get_num_threads();
+    for (std::size_t block = omp_get_thread_num(); block < blocks;
+         block += nthreads) {
+      const std::size_t begin = block * search_block_size;
+      if (begin >= first.load(std::memory_order_relaxed))
+        break;
+      const std::size_t end = std::min(begin + search_block_size, size);
+      std::size_t i = begin;
+      while (i < end && !pred(i))
+        i++;
+      if (i < end) {
+        std::size_t found = first.load(std::memory_order_relaxed);
+        while (i < found && !first.compare_exchange_weak(
+                                found, i, std::memory_order_relaxed))
+          ;
+        break;
+      }
+    }
+  }
+  return first.load();
+}
+
+/// number of indices i for which pred(i) holds
+template <typename Predicate>
+std::size_t offload_count_if(vecpar::config config, std::size_t size,
+                             Predicate pred) {
+  std::size_t count = 0;
+#pragma omp parallel for simd num_threads(get_num_threads(config))           \
+    reduction(+ : count)
+  for (std::size_t i = 0; i < size; i++)
+    count += pred(i) ? 1 : 0;
+  return count;
+}
+
+/// the i-th item of a map algorithm, computed into a temporary (InPlace for
+/// mmap algorithms, which update data[i]) instead of a result collection
+template <typename Item, bool InPlace, class Algorithm, typename T,
+          typename... Arguments>
+Item map_item(Algorithm &algorithm, std::size_t i, T &data,
+              Arguments &...args) {
+  const int idx = static_cast<int>(i);
+  if constexpr (InPlace) {
+    vecpar::detail::call_mapping_function(algorithm, i, data[idx],
+                                          get(idx, args)...);
+    return data[idx];
+  } else {
+    Item item{};
+    vecpar::detail::call_mapping_function(algorithm, i, item, data[idx],
+                                          get(idx, args)...);
+    return item;
+  }
+}
+
+/// the first item of value(0), ..., value(size - 1) for which no other item
+/// compares before it; on ties the lowest index wins. An empty input gives
+/// index == size.
+template <typename T, typename Compare, typename Value>
+vecpar::collection::location<T> offload_arg_best(vecpar::config config,
+                                                 std::size_t size,
+                                                 Compare comp, Value value) {
+  using location_t = vecpar::collection::location<T>;
+  return offload_accumulate(
+      config, size, location_t{T(), size},
+      [&](location_t &best, std::size_t i) {
+        T item = value(i);
+        if (best.index == size || comp(item, best.value))
+          best = location_t{item, i};
+      },
+      // partials come in thread order, i.e. with increasing indices
+      [&](location_t &best, const location_t &partial) {
+        if (partial.index != size &&
+            (best.index == size || comp(partial.value, best.value)))
+          best = partial;
+      });
+}
+
+/// largest k handled with a sorted array and insertion
+constexpr std::size_t top_k_insertion_limit = 16;
+
+/// largest k handled with per-thread heaps; above it the serial merge of
+/// the heaps would dominate, so the items are selected in parallel
+constexpr std::size_t top_k_heap_limit = 2048;
+
+/// item of a top-k selection with its position, which breaks the ties
+template <typename T> struct ranked_item {
+  T value;
+  std::size_t index;
+};
+
+/// positions in the sorted runs such that the items before them are the
+/// rank first items of all the runs (ordered by before, a strict total
+/// order): the range of every run is narrowed around the item in the middle
+/// of the widest range until all the ranges are empty
+template <typename T, typename Before>
+std::vector<std::size_t>
+multiway_split(const std::vector<std::span<const T>> &runs, std::size_t rank,
+               Before before) {
+  const std::size_t n = runs.size();
+  std::vector<std::size_t> lo(n, 0), hi(n);
+  for (std::size_t r = 0; r < n; r++)
+    hi[r] = std::min(runs[r].size(), rank);
+
+  while (true) {
+    std::size_t widest = n;
+    for (std::size_t r = 0; r < n; r++)
+      if (hi[r] > lo[r] &&
+          (widest == n || hi[r] - lo[r] > hi[widest] - lo[widest]))
+        widest = r;
+    if (widest == n)
+      return lo;
+
+    const T &pivot = runs[widest][(lo[widest] + hi[widest]) / 2];
+    std::vector<std::size_t> less(n);
+    std::size_t total = 0;
+    for (std::size_t r = 0; r < n; r++) {
+      less[r] = std::lower_bound(runs[r].begin(), runs[r].end(), pivot,
+                                 before) -
+                runs[r].begin();
+      total += less[r];
+    }
+    if (total < rank) {
+      // the pivot and all the items before it are selected
+      for (std::size_t r = 0; r < n; r++)
+        lo[r] = std::max(lo[r], less[r] + (r == widest ? 1 : 0));
+    } else {
+      for (std::size_t r = 0; r < n; r++)
+        hi[r] = std::min(hi[r], less[r]);
+    }
+  }
+}
+
+/// offload_top_k for large k: every thread computes the items of its chunk
+/// and sorts the k best of them; the output is then split between the
+/// threads by rank (see multiway_split) and every thread merges its part
+/// of the runs, so that neither the selection nor the merge is serial
+template <typename T, typename Compare, typename Value>
+std::vector<T> offload_top_k_selection(vecpar::config config,
+                                       std::size_t size, std::size_t k,
+                                       Compare comp, Value value) {
+  using item_t = ranked_item<T>;
+  const auto before = [&](const item_t &a, const item_t &b) {
+    return comp(a.value, b.value) ||
+           (!comp(b.value, a.value) && a.index < b.index);
+  };
+
+  const int max_threads = get_num_threads(config);
+  std::vector<item_t> items(size);
+  std::vector<std::span<const item_t>> runs(max_threads);
+  std::vector<T> best(k);
+#pragma omp parallel num_threads(max_threads)
+  {
+    const int tid = omp_get_thread_num();
+    const int nthreads = omp_get_num_threads();
+    const std::size_t begin = chunk_begin(size, tid, nthreads);
+    const std::size_t end = chunk_begin(size, tid + 1, nthreads);
+    for (std::size_t i = begin; i < end; i++)
+      items[i] = {value(i), i};
+    const std::size_t kept = std::min(k, end - begin);
+    std::partial_sort(items.begin() + begin, items.begin() + begin + kept,
+                      items.begin() + end, before);
+    runs[tid] = {items.data() + begin, kept};
+#pragma omp barrier
+
+    const std::size_t first = chunk_begin(k, tid, nthreads);
+    const std::size_t last = chunk_begin(k, tid + 1, nthreads);
+    if (first < last) {
+      std::vector<std::size_t> next = multiway_split(runs, first, before);
+      const std::vector<std::size_t> stop = multiway_split(runs, last, before);
+      for (std::size_t out = first; out < last; out++) {
+        std::size_t from = runs.size();
+        for (std::size_t r = 0; r < runs.size(); r++)
+          if (next[r] < stop[r] &&
+              (from == runs.size() || before(runs[r][next[r]],
+                                             runs[from][next[from]])))
+            from = r;
+        best[out] = runs[from][next[from]++].value;
+      }
+    }
+  }
+  return best;
+}
+
+/// the k first items of value(0), ..., value(size - 1) according to comp,
+/// sorted. Every thread keeps the best items of its chunk in a bounded buffer
+/// (a sorted array for small k, a heap otherwise), so the input is never
+/// copied; the sorted buffers are then merged until k items are taken.
+/// Above top_k_heap_limit the items are selected in parallel instead.
+template <typename T, typename Compare, typename Value>
+std::vector<T> offload_top_k(vecpar::config config, std::size_t size,
+                             std::size_t k, Compare comp, Value value) {
+  k = std::min(k, size);
+  std::vector<T> best;
+  if (k == 0)
+    return best;
+  if constexpr (std::is_default_constructible_v<T>) {
+    if (k > top_k_heap_limit)
+      return offload_top_k_selection<T>(config, size, k, comp, value);
+  }
+
+  const int max_threads = get_num_threads(config);
+  std::vector<std::vector<T>> partials(max_threads);
+#pragma omp parallel num_threads(max_threads)
+  {
+    const int tid = omp_get_thread_num();
+    const int nthreads = omp_get_num_threads();
+    const std::size_t begin = chunk_begin(size, tid, nthreads);
+    const std::size_t end = chunk_begin(size, tid + 1, nthreads);
+
+    std::vector<T> &local = partials[tid];
+    local.reserve(std::min(k, end - begin) + 1);
+    for (std::size_t i = begin; i < end; i++) {
+      T item = value(i);
+      if (k <= top_k_insertion_limit) {
+        if (local.size() == k && !comp(item, local.back()))
+          continue;
+        local.insert(std::upper_bound(local.begin(), local.end(), item, comp),
+                     item);
+        if (local.size() > k)
+          local.pop_back();
+      } else if (local.size() < k) {
+        // heap with the worst kept item on top
+        local.push_back(item);
+        std::push_heap(local.begin(), local.end(), comp);
+      } else if (comp(item, local.front())) {
+        std::pop_heap(local.begin(), local.end(), comp);
+        local.back() = item;
+        std::push_heap(local.begin(), local.end(), comp);
+      }
+    }
+    if (k > top_k_insertion_limit)
+      std::sort_heap(local.begin(), local.end(), comp);
+  }
+
+  // k-way merge of the sorted buffers; on ties the lower thread, i.e. the
+  // lower index, comes first
+  std::vector<std::size_t> next(max_threads, 0);
+  best.reserve(k);
+  while (best.size() < k) {
+    int from = -1;
+    for (int t = 0; t < max_threads; t++) {
+      if (next[t] < partials[t].size() &&
+          (from < 0 || comp(partials[t][next[t]], partials[from][next[from]])))
+        from = t;
+    }
+    best.push_back(partials[from][next[from]++]);
+  }
+  return best;
+}
+
+/// reduction lowered to an OpenMP reduction clause, value(i) being the i-th
+/// reduced element. Arithmetic types use the built-in operators (with SIMD
+/// accumulators); for other types an OpenMP reduction is declared from the
+/// (stateless) reducer.
+template <vecpar::reducers::native_op Op, typename Reducer, typename Acc,
+          typename Value>
+Acc offload_native_reduce(vecpar::config config, std::size_t size, Acc result,
+                          Value value) {
+  using vecpar::reducers::native_op;
+  const int threads = get_num_threads(config);
+
+  if constexpr (!std::is_arithmetic_v<Acc>) {
+#pragma omp declare reduction(vecpar_reducer : Acc : Reducer().combine(omp_out, omp_in)) \
+    initializer(omp_priv = vecpar::reducers::identity<Acc>(Reducer()))
+#pragma omp parallel for num_threads(threads) reduction(vecpar_reducer : result)
+    for (std::size_t i = 0; i < size; i++)
+      Reducer().accumulate(result, value(i));
+  } else if constexpr (Op == native_op::plus) {
+#pragma omp parallel for simd num_threads(threads) reduction(+ : result)
+    for (std::size_t i = 0; i < size; i++)
+      result += value(i);
+  } else if constexpr (Op == native_op::multiplies) {
+#pragma omp parallel for simd num_threads(threads) reduction(* : result)
+    for (std::size_t i = 0; i < size; i++)
+      result *= value(i);
+  } else if constexpr (Op == native_op::min) {
+#pragma omp parallel for simd num_threads(threads) reduction(min : result)
+    for (std::size_t i = 0; i < size; i++)
+      result = std::min<Acc>(result, value(i));
+  } else if constexpr (Op == native_op::max) {
+#pragma omp parallel for simd num_threads(threads) reduction(max : result)
+    for (std::size_t i = 0; i < size; i++)
+      result = std::max<Acc>(result, value(i));
+  } else if constexpr (Op == native_op::bit_and) {
+#pragma omp parallel for simd num_threads(threads) reduction(& : result)
+    for (std::size_t i = 0; i < size; i++)
+      result &= value(i);
+  } else if constexpr (Op == native_op::bit_or) {
+#pragma omp parallel for simd num_threads(threads) reduction(| : result)
+    for (std::size_t i = 0; i < size; i++)
+      result |= value(i);
+  } else if constexpr (Op == native_op::bit_xor) {
+#pragma omp parallel for simd num_threads(threads) reduction(^ : result)
+    for (std::size_t i = 0; i < size; i++)
+      result ^= value(i);
+  }
+  return result;
+}
+
+/// stable stream compaction: stores, in increasing order, the indices from
+/// [0, size) for which the predicate holds. Each thread collects the indices
+/// of its own contiguous chunk, the chunks are then concatenated.
+template <typename Index, typename Predicate>
+void offload_select(vecpar::config config, std::size_t size,
+                    vecmem::vector<Index> &result, Predicate p) {
+  const int max_threads = get_num_threads(config);
+  std::vector<std::size_t> offsets(max_threads + 1, 0);
+
+#pragma omp parallel num_threads(max_threads)
+  {
+    const int tid = omp_get_thread_num();
+    const int nthreads = omp_get_num_threads();
+
+    std::vector<Index> local;
+    for (std::size_t i = chunk_begin(size, tid, nthreads);
+         i < chunk_begin(size, tid + 1, nthreads); i++) {
+      if (p(i))
+        local.push_back(static_cast<Index>(i));
+    }
+    offsets[tid + 1] = local.size();
+
+#pragma omp barrier
+#pragma omp single
+    {
+      for (int t = 0; t < nthreads; t++)
+        offsets[t + 1] += offsets[t];
+      result.resize(offsets[nthreads]);
+    }
+
+    std::copy(local.begin(), local.end(), result.begin() + offsets[tid]);
+  }
+}
+
+/// sets bit i of the mask when the predicate holds for index i;
+/// every word is written by exactly one thread
+template <typename Predicate>
+void offload_mask(vecpar::config config, std::size_t size,
+                  vecpar::collection::bitmask &mask, Predicate p) {
+  using vecpar::collection::bitmask_word_bits;
+  const std::size_t words = vecpar::collection::bitmask_words(size);
+#pragma omp parallel for num_threads(get_num_threads(config))
+  for (std::size_t w = 0; w < words; w++) {
+    std::uint64_t word = 0;
+    const std::size_t first = w * bitmask_word_bits;
+    const std::size_t end = std::min(size, first + bitmask_word_bits);
+    for (std::size_t i = first; i < end; i++) {
+      if (p(i))
+        word |= std::uint64_t(1) << (i - first);
+    }
+    mask[w] = word;
+  }
+}
+
+/// the mask word w, without the bits at positions >= size
+static inline std::uint64_t
+mask_word(const vecpar::collection::bitmask &mask, std::size_t w,
+          std::size_t size) {
+  using vecpar::collection::bitmask_word_bits;
+  std::uint64_t word = mask[w];
+  if ((w + 1) * bitmask_word_bits > size)
+    word &= (std::uint64_t(1) << (size % bitmask_word_bits)) - 1;
+  return word;
+}
+
+/// number of set bits among the first size bits of the mask
+static inline std::size_t
+count_set_bits(vecpar::config config, const vecpar::collection::bitmask &mask,
+               std::size_t size) {
+  const std::size_t words = vecpar::collection::bitmask_words(size);
+  std::size_t count = 0;
+#pragma omp parallel for num_threads(get_num_threads(config))                 \
+    reduction(+ : count)
+  for (std::size_t w = 0; w < words; w++) {
+    count += std::popcount(mask_word(mask, w, size));
+  }
+  return count;
+}
+
+/// ordered positions of the set bits among the first size bits of the
+/// mask; every thread compacts a block of words
+static inline std::vector<std::size_t>
+set_bit_positions(vecpar::config config,
+                  const vecpar::collection::bitmask &mask, std::size_t size) {
+  using vecpar::collection::bitmask_word_bits;
+  const std::size_t words = vecpar::collection::bitmask_words(size);
+  const int max_threads = get_num_threads(config);
+  std::vector<std::size_t> offsets(max_threads + 1, 0);
+  std::vector<std::size_t> positions;
+
+#pragma omp parallel num_threads(max_threads)
+  {
+    const int tid = omp_get_thread_num();
+    const int nthreads = omp_get_num_threads();
+    const std::size_t begin = chunk_begin(words, tid, nthreads);
+    const std::size_t end = chunk_begin(words, tid + 1, nthreads);
+
+    std::size_t count = 0;
+    for (std::size_t w = begin; w < end; w++)
+      count += std::popcount(mask_word(mask, w, size));
+    offsets[tid + 1] = count;
+
+#pragma omp barrier
+#pragma omp single
+    {
+      for (int t = 0; t < nthreads; t++)
+        offsets[t + 1] += offsets[t];
+      positions.resize(offsets[nthreads]);
+    }
+
+    std::size_t out = offsets[tid];
+    for (std::size_t w = begin; w < end; w++) {
+      for (std::uint64_t word = mask_word(mask, w, size); word != 0;
+           word &= word - 1)
+        positions[out++] = w * bitmask_word_bits + std::countr_zero(word);
+    }
+  }
+  return positions;
+}
+
+/// share of set bits from which a masked map tests the bit of every element
+/// instead of going through the list of set positions: below it, most of the
+/// vector lanes of a word would be masked off
+constexpr double masked_map_dense_threshold = 0.125;
+
+/// calls f(i) for every position i < size whose bit is set in the mask.
+/// Dense masks are processed word by word with the bit as the condition of
+/// a SIMD loop (masked stores); sparse masks are first compacted into the
+/// ordered list of set positions, which the threads then share evenly.
+template <typename Function>
+void offload_masked(vecpar::config config,
+                    const vecpar::collection::bitmask &mask, std::size_t size,
+                    Function f) {
+  using vecpar::collection::bitmask_word_bits;
+  const int max_threads = get_num_threads(config);
+  const std::size_t set = count_set_bits(config, mask, size);
+  if (set == 0)
+    return;
+
+  if (set >= masked_map_dense_threshold * size) {
+    const std::size_t words = vecpar::collection::bitmask_words(size);
+#pragma omp parallel for num_threads(max_threads)
+    for (std::size_t w = 0; w < words; w++) {
+      const std::uint64_t word = mask[w];
+      const std::size_t first = w * bitmask_word_bits;
+      const std::size_t bits = std::min(bitmask_word_bits, size - first);
+#pragma omp simd
+      for (std::size_t b = 0; b < bits; b++) {
+        if ((word >> b) & 1u)
+          f(first + b);
+      }
+    }
+    return;
+  }
+
+  const std::vector<std::size_t> positions =
+      set_bit_positions(config, mask, size);
+#pragma omp parallel for num_threads(max_threads)
+  for (std::size_t k = 0; k < positions.size(); k++)
+    f(positions[k]);
+}
+
+/// in-place stable compaction: moves the elements for which the predicate
+/// holds to the front of the collection and resizes it.
+/// (1) every thread compacts its own contiguous block,
+/// (2) a prefix sum over the block counts gives the destination of each block,
+/// (3) the blocks are moved to their destination in waves; a block is moved
+///     only after every block whose compacted range overlaps its destination.
+/// The predicate is evaluated exactly once for every index, before the
+/// element at that index is moved.
+template <typename T, typename Predicate>
+void offload_compact(vecpar::config config, T &data, Predicate p) {
+  const std::size_t size = data.size();
+  const int max_threads = get_num_threads(config);
+  std::vector<std::size_t> count(max_threads, 0);
+  std::vector<std::size_t> offset(max_threads + 1, 0);
+  std::vector<int> wave(max_threads, 0);
+  int waves = 0;
+  int blocks = 0;
+
+#pragma omp parallel num_threads(max_threads)
+  {
+    const int tid = omp_get_thread_num();
+    const int nthreads = omp_get_num_threads();
+    const std::size_t begin = chunk_begin(size, tid, nthreads);
+    const std::size_t end = chunk_begin(size, tid + 1, nthreads);
+
+    // (1) block-local compaction
+    std::size_t last = begin;
+    for (std::size_t i = begin; i < end; i++) {
+      if (p(i)) {
+        if (last != i)
+          data[last] = std::move(data[i]);
+        last++;
+      }
+    }
+    count[tid] = last - begin;
+
+#pragma omp barrier
+#pragma omp single
+    {
+      // (2) destination of each block
+      blocks = nthreads;
+      for (int b = 0; b < blocks; b++)
+        offset[b + 1] = offset[b] + count[b];
+
+      // the destination of a block can only overlap the compacted range of
+      // an earlier block, which therefore has to be moved first
+      for (int b = 0; b < blocks; b++) {
+        const std::size_t b_begin = chunk_begin(size, b, blocks);
+        if (count[b] == 0 || offset[b] == b_begin)
+          continue;
+        for (int prev = 0; prev < b; prev++) {
+          const std::size_t prev_begin = chunk_begin(size, prev, blocks);
+          const bool overlaps = count[prev] > 0 &&
+                                offset[prev] != prev_begin &&
+                                prev_begin < offset[b + 1] &&
+                                offset[b] < prev_begin + count[prev];
+          if (overlaps)
+            wave[b] = std::max(wave[b], wave[prev] + 1);
+        }
+        waves = std::max(waves, wave[b] + 1);
+      }
+    }
+
+    // (3) block moves, one wave at a time
+    for (int w = 0; w < waves; w++) {
+      if (wave[tid] == w && count[tid] > 0 && offset[tid] != begin) {
+        std::move(data.begin() + begin, data.begin() + begin + count[tid],
+                  data.begin() + offset[tid]);
+      }
+#pragma omp barrier
+    }
+  }
+  data.resize(offset[blocks]);
+}
+
+/// exclusive prefix sum: out[i] is the sum of in(j) for j < i and
+/// out[size] is the total. Every thread scans its own contiguous chunk twice
+/// (count, then write), so in(i) should be cheap to evaluate.
+template <typename Input, typename Output>
+void offload_scan(vecpar::config config, std::size_t size, Input in,
+                  Output &out) {
+  const int max_threads = get_num_threads(config);
+  std::vector<std::size_t> partial(max_threads + 1, 0);
+  out.resize(size + 1);
+
+#pragma omp parallel num_threads(max_threads)
+  {
+    const int tid = omp_get_thread_num();
+    const int nthreads = omp_get_num_threads();
+    const std::size_t begin = chunk_begin(size, tid, nthreads);
+    const std::size_t end = chunk_begin(size, tid + 1, nthreads);
+
+    std::size_t sum = 0;
+    for (std::size_t i = begin; i < end; i++)
+      sum += in(i);
+    partial[tid + 1] = sum;
+
+#pragma omp barrier
+#pragma omp single
+    {
+      for (int t = 0; t < nthreads; t++)
+        partial[t + 1] += partial[t];
+      out[size] = partial[nthreads];
+    }
+
+    sum = partial[tid];
+    for (std::size_t i = begin; i < end; i++) {
+      out[i] = sum;
+      sum += in(i);
+    }
+  }
+}
+
+/// offsets of the output ranges of size count(i) for i in [0, size),
+/// written into offsets; the counts are evaluated once, in parallel, before
+/// the scan
+template <typename Count, typename Output>
+void count_offsets(vecpar::config config, std::size_t size, Count count,
+                   Output &offsets) {
+  std::vector<std::size_t> counts(size);
+#pragma omp parallel for num_threads(get_num_threads(config))
+  for (std::size_t i = 0; i < size; i++)
+    counts[i] = count(i);
+
+  offload_scan(
+      config, size, [&](std::size_t i) { return counts[i]; }, offsets);
+}
+
+template <typename Count>
+std::vector<std::size_t> count_offsets(vecpar::config config, std::size_t size,
+                                       Count count) {
+  std::vector<std::size_t> offsets;
+  count_offsets(config, size, count, offsets);
+  return offsets;
+}
+
+/// sizes the values of a csr_vector whose offsets are set and points its
+/// rows into them
+template <typename T>
+void fill_csr_rows(vecpar::config config,
+                   vecpar::collection::csr_vector<T> &csr) {
+  const std::size_t rows = csr.offsets.size() - 1;
+  csr.values.resize(csr.offsets.back());
+  csr.rows.resize(rows);
+
+#pragma omp parallel for num_threads(get_num_threads(config))
+  for (std::size_t row = 0; row < rows; row++)
+    csr.rows[row] = vecmem::data::vector_view<T>(
+        static_cast<typename vecmem::data::vector_view<T>::size_type>(
+            csr.offsets[row + 1] - csr.offsets[row]),
+        csr.values.data() + csr.offsets[row]);
+}
+
+/// offsets of the rows of a jagged collection in its flattened element
+/// space; the last entry is the total number of elements
+template <typename T>
+std::vector<std::size_t> jagged_offsets(vecpar::config config, T &data) {
+  std::vector<std::size_t> offsets;
+  offload_scan(
+      config, data.size(),
+      [&](std::size_t row) -> std::size_t { return data[row].size(); },
+      offsets);
+  return offsets;
+}
+
+/// throws std::length_error unless the jagged collections among others
+/// have the same number of rows as data, with the same row sizes (the
+/// other arguments of an elementwise map are indexed by row only)
+template <typename T, typename... Others>
+void check_jagged_shapes(const T &data, const Others &...others) {
+  auto check = [&]<typename C>(const C &other) {
+    if constexpr (vecpar::collection::Jagged_vector_type<C>) {
+      bool same = other.size() == data.size();
+      for (std::size_t row = 0; same && row < data.size(); row++)
+        same = other[row].size() == data[row].size();
+      if (!same)
+        throw std::length_error(
+            "the jagged inputs of an elementwise map differ in shape");
+    }
+  };
+  (check(others), ...);
+}
+
+/// splits the flattened element space of a jagged collection evenly between
+/// the threads, independently of the row lengths. f(row, begin, end) is
+/// called for every part [begin, end) of a row owned by the calling thread;
+/// a long row can be split between several consecutive threads.
+template <typename Offsets, typename Function>
+void offload_jagged(vecpar::config config, const Offsets &offsets,
+                    Function f) {
+  const std::size_t total = offsets.back();
+
+#pragma omp parallel num_threads(get_num_threads(config))
+  {
+    const int tid = omp_get_thread_num();
+    const int nthreads = omp_get_num_threads();
+    std::size_t i = chunk_begin(total, tid, nthreads);
+    const std::size_t last = chunk_begin(total, tid + 1, nthreads);
+
+    if (i < last) {
+      // the row holding the first element of the chunk (empty rows skipped)
+      std::size_t row =
+          std::upper_bound(offsets.begin(), offsets.end(), i) -
+          offsets.begin() - 1;
+      for (; i < last; row++) {
+        const std::size_t end = std::min(last, offsets[row + 1]);
+        if (i < end) {
+          f(row, i - offsets[row], end - offsets[row]);
+          i = end;
+        }
+      }
+    }
+  }
+}
+
+/// sliding window with a running update: out[i] combines in[i, i + window).
+/// Every thread computes the first window of its chunk from scratch (the
+/// halo) and then slides it, adding the entering and removing the leaving
+/// element, so the work does not depend on the window size.
+template <typename T, typename R, typename Add, typename Remove>
+void offload_window_running(vecpar::config config, T &in, std::size_t window,
+                            R &out, Add add, Remove remove) {
+  const std::size_t size = out.size();
+
+#pragma omp parallel num_threads(get_num_threads(config))
+  {
+    const int tid = omp_get_thread_num();
+    const int nthreads = omp_get_num_threads();
+    const std::size_t begin = chunk_begin(size, tid, nthreads);
+    const std::size_t end = chunk_begin(size, tid + 1, nthreads);
+
+    if (begin < end) {
+      typename R::value_type acc = in[begin];
+      for (std::size_t i = begin + 1; i < begin + window; i++)
+        add(&acc, in[i]);
+      out[begin] = acc;
+
+      for (std::size_t i = begin + 1; i < end; i++) {
+        remove(&acc, in[i - 1]);
+        add(&acc, in[i + window - 1]);
+        out[i] = acc;
+      }
+    }
+  }
+}
+
+/// sliding window for any associative operation (van Herk/Gil-Werman):
+/// the input is split in blocks of window elements and, for every block,
+/// the prefix and suffix reductions are computed. A window starting at i
+/// is then the suffix of its first block from i combined with the prefix
+/// of the next block up to i + window - 1, i.e. three combinations per
+/// element whatever the window size.
+template <typename T, typename R, typename Combine>
+void offload_window_blocked(vecpar::config config, T &in, std::size_t window,
+                            R &out, Combine combine) {
+  using value_t = typename R::value_type;
+  const std::size_t size = in.size();
+  const std::size_t blocks = (size + window - 1) / window;
+  std::vector<value_t> prefix(size);
+  std::vector<value_t> suffix(size);
+
+#pragma omp parallel num_threads(get_num_threads(config))
+  {
+#pragma omp for
+    for (std::size_t b = 0; b < blocks; b++) {
+      const std::size_t first = b * window;
+      const std::size_t last = std::min(size, first + window);
+
+      prefix[first] = in[first];
+      for (std::size_t i = first + 1; i < last; i++) {
+        prefix[i] = prefix[i - 1];
+        combine(&prefix[i], in[i]);
+      }
+
+      suffix[last - 1] = in[last - 1];
+      for (std::size_t i = last - 1; i-- > first;) {
+        suffix[i] = in[i];
+        combine(&suffix[i], suffix[i + 1]);
+      }
+    }
+
+#pragma omp for
+    for (std::size_t i = 0; i < out.size(); i++) {
+      const std::size_t last = i + window - 1;
+      if (i % window == 0) {
+        out[i] = prefix[last];
+      } else {
+        out[i] = suffix[i];
+        combine(&out[i], prefix[last]);
+      }
+    }
+  }
+}
 } // namespace internal
 #endif // VECPAR_OMP_INTERNAL_HPP
@@ -2,20 +2,31 @@
 #define VECPAR_OMP_PARALLELIZATION_HPP
 
 #include <cmath>
+#include <cstdint>
+#include <functional>
 #include <omp.h>
+#include <span>
+#include <stdexcept>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <vecmem/memory/memory_resource.hpp>
 
 #include "vecpar/core/algorithms/parallelizable_filter.hpp"
+#include "vecpar/core/algorithms/parallelizable_flat_map.hpp"
 #include "vecpar/core/algorithms/parallelizable_map.hpp"
 #include "vecpar/core/algorithms/parallelizable_map_filter.hpp"
 #include "vecpar/core/algorithms/parallelizable_map_reduce.hpp"
 #include "vecpar/core/algorithms/parallelizable_reduce.hpp"
+#include "vecpar/core/algorithms/parallelizable_window_reduce.hpp"
+#include "vecpar/core/algorithms/reducers.hpp"
 #include "vecpar/core/definitions/config.hpp"
+#include "vecpar/core/definitions/csr.hpp"
 
 #include "vecpar/core/definitions/helper.hpp"
+#include "vecpar/core/definitions/selection.hpp"
+#include "vecpar/core/definitions/soa.hpp"
 #include "vecpar/omp/detail/internal.hpp"
 
 namespace vecpar::omp {
@@ -46,9 +57,34 @@ parallel_map(Algorithm &algorithm,
              vecmem::memory_resource &mr,
              vecpar::config config, T &data, Rest &...rest) {
   R *map_result = new R(data.size(), &mr);
-  internal::offload_map(config, data.size(), [&](int idx) {
-      algorithm.mapping_function(map_result->at(idx), data[idx], get(idx, rest)...);
-  });
+  if constexpr (internal::is_staged_map<Algorithm, R, T, Rest...>) {
+    internal::offload_map_staged<false>(config, algorithm, *map_result, data,
+                                        rest...);
+    return *map_result;
+  } else if constexpr (internal::is_streamable_result<R>) {
+    if (internal::use_streaming_stores(
+            config, data.size() * sizeof(typename R::value_type))) {
+      internal::offload_map_streaming(config, algorithm, *map_result, data,
+                                      rest...);
+      return *map_result;
+    }
+  }
+  if constexpr (internal::is_aligned_map<Algorithm, R, T, Rest...>) {
+    if (internal::cache_line_aligned<Algorithm::input_count + 1>(
+            *map_result, data, rest...)) {
+      internal::offload_map_aligned<false>(config, algorithm, *map_result,
+                                           data, rest...);
+      return *map_result;
+    }
+  }
+  internal::offload_map_scratch(
+      config, data.size(), algorithm,
+      [&](int idx, vecpar::scratch &s) {
+        vecpar::detail::call_mapping_function(algorithm, idx, s,
+                                              (*map_result)[idx], data[idx],
+                                              get(idx, rest)...);
+      },
+      internal::cache_line_grain(*map_result));
   return *map_result;
 }
 
@@ -66,20 +102,35 @@ parallel_map(Algorithm &algorithm,
 template <class Algorithm,
           typename R = typename Algorithm::intermediate_result_t, typename T,
           typename... Rest>
-requires detail::is_mmap<Algorithm, T, Rest...> R &
+requires detail::is_mmap<Algorithm, T, Rest...> T &
 parallel_map(Algorithm &algorithm,
              __attribute__((unused)) vecmem::memory_resource &mr,
              vecpar::config config, T &data, Rest &...rest) {
-  internal::offload_map(config, data.size(), [&](int idx) {
-      algorithm.mapping_function(data[idx], get(idx, rest)...);
-  });
+  if constexpr (internal::is_staged_map<Algorithm, T, Rest...>) {
+    internal::offload_map_staged<true>(config, algorithm, data, data,
+                                       rest...);
+    return data;
+  } else if constexpr (internal::is_aligned_mmap<Algorithm, T, Rest...>) {
+    if (internal::cache_line_aligned<Algorithm::input_count>(data, rest...)) {
+      internal::offload_map_aligned<true>(config, algorithm, data, data,
+                                          rest...);
+      return data;
+    }
+  }
+  internal::offload_map_scratch(
+      config, data.size(), algorithm,
+      [&](int idx, vecpar::scratch &s) {
+        vecpar::detail::call_mapping_function(algorithm, idx, s, data[idx],
+                                              get(idx, rest)...);
+      },
+      internal::cache_line_grain(data));
   return data;
 }
 
 template <class Algorithm,
           typename R = typename Algorithm::intermediate_result_t, typename T,
           typename... Rest>
-requires detail::is_mmap<Algorithm, T, Rest...> R &
+requires detail::is_mmap<Algorithm, T, Rest...> T &
 parallel_map(Algorithm &algorithm,
              __attribute__((unused)) vecmem::memory_resource &mr, T &data,
              Rest &...rest) {
@@ -87,8 +138,394 @@ parallel_map(Algorithm &algorithm,
                                    rest...);
 }
 
+/// map which writes into a container chosen by the caller (e.g. a
+/// std::vector or a view) instead of allocating the result; a resizable
+/// container is grown to the size of the input
+template <class Algorithm,
+          typename R = typename Algorithm::intermediate_result_t,
+          typename Out, typename T, typename... Rest>
+requires detail::is_map<Algorithm, R, T, Rest...> &&
+    std::same_as<std::remove_cvref_t<decltype(std::declval<Out &>()[0])>,
+                 typename R::value_type>
+        Out &parallel_map_into(Algorithm &algorithm, Out &out,
+                               vecpar::config config, T &data,
+                               Rest &...rest) {
+  if (out.size() < data.size()) {
+    if constexpr (requires { out.resize(data.size()); })
+      out.resize(data.size());
+    else
+      throw std::length_error("the result container is smaller than the input");
+  }
+  if constexpr (internal::is_streamable_result<Out>) {
+    if (internal::use_streaming_stores(config,
+                                       data.size() * sizeof(out[0]))) {
+      internal::offload_map_streaming(config, algorithm, out, data, rest...);
+      return out;
+    }
+  }
+  internal::offload_map_scratch(
+      config, data.size(), algorithm,
+      [&](int idx, vecpar::scratch &s) {
+        vecpar::detail::call_mapping_function(algorithm, idx, s, out[idx],
+                                              data[idx], get(idx, rest)...);
+      },
+      internal::cache_line_grain(out));
+  return out;
+}
+
+template <class Algorithm,
+          typename R = typename Algorithm::intermediate_result_t,
+          typename Out, typename T, typename... Rest>
+requires detail::is_map<Algorithm, R, T, Rest...> &&
+    std::same_as<std::remove_cvref_t<decltype(std::declval<Out &>()[0])>,
+                 typename R::value_type>
+        Out &parallel_map_into(Algorithm &algorithm, Out &out, T &data,
+                               Rest &...rest) {
+  return vecpar::omp::parallel_map_into(algorithm, out,
+                                        omp::getDefaultConfig(), data, rest...);
+}
+
+/// container initialization: the items are written in parallel, split
+/// between the threads as the results of a map over the same collection
+/// (cache-line aligned ranges for aligned storage, streaming stores if
+/// config::m_storeHint asks for them), so that the pages are first
+/// touched by the threads which later process them
+
+/// data[i] = value for every item
+template <typename T>
+T &parallel_fill(vecpar::config config, T &data,
+                 const vecpar::collection::value_type_t<T> &value) {
+  internal::offload_write(config, data, data.size(),
+                          [&](std::size_t) { return value; });
+  return data;
+}
+
+template <typename T>
+T &parallel_fill(T &data, const vecpar::collection::value_type_t<T> &value) {
+  return vecpar::omp::parallel_fill(omp::getDefaultConfig(), data, value);
+}
+
+/// data[i] = first + i for every item
+template <typename T>
+T &parallel_iota(vecpar::config config, T &data,
+                 vecpar::collection::value_type_t<T> first) {
+  internal::offload_write(config, data, data.size(), [&](std::size_t i) {
+    return static_cast<vecpar::collection::value_type_t<T>>(first + i);
+  });
+  return data;
+}
+
+template <typename T>
+T &parallel_iota(T &data, vecpar::collection::value_type_t<T> first) {
+  return vecpar::omp::parallel_iota(omp::getDefaultConfig(), data, first);
+}
+
+/// data[i] = generator(i) for every item; the generator is called
+/// concurrently, in no particular order
+template <typename T, typename Generator>
+requires std::convertible_to<std::invoke_result_t<Generator &, std::size_t>,
+                             vecpar::collection::value_type_t<T>>
+    T &parallel_generate(vecpar::config config, T &data,
+                         Generator generator) {
+  internal::offload_write(config, data, data.size(), generator);
+  return data;
+}
+
+template <typename T, typename Generator>
+requires std::convertible_to<std::invoke_result_t<Generator &, std::size_t>,
+                             vecpar::collection::value_type_t<T>>
+    T &parallel_generate(T &data, Generator generator) {
+  return vecpar::omp::parallel_generate(omp::getDefaultConfig(), data,
+                                        generator);
+}
+
+/// copies the items of from into to; a resizable destination is grown to
+/// the size of the source
+template <typename From, typename To>
+To &parallel_copy(vecpar::config config, const From &from, To &to) {
+  if (to.size() < from.size()) {
+    if constexpr (requires { to.resize(from.size()); })
+      to.resize(from.size());
+    else
+      throw std::length_error(
+          "the destination container is smaller than the source");
+  }
+  internal::offload_write(config, to, from.size(),
+                          [&](std::size_t i) { return from[i]; });
+  return to;
+}
+
+template <typename From, typename To>
+To &parallel_copy(const From &from, To &to) {
+  return vecpar::omp::parallel_copy(omp::getDefaultConfig(), from, to);
+}
+
+/// new vector of size items equal to value; its pages are first touched by
+/// the threads which process them in a map over the vector, before the
+/// items are constructed, and the items are then written by parallel_fill
+/// at the same grain
+template <typename T>
+vecmem::vector<T> &parallel_make_vector(vecpar::config config,
+                                        vecmem::memory_resource &mr,
+                                        std::size_t size,
+                                        const T &value = T()) {
+  vecmem::vector<T> *result = new vecmem::vector<T>(&mr);
+  internal::first_touch_resize(config, *result, size);
+  return vecpar::omp::parallel_fill(config, *result, value);
+}
+
+template <typename T>
+vecmem::vector<T> &parallel_make_vector(vecmem::memory_resource &mr,
+                                        std::size_t size,
+                                        const T &value = T()) {
+  return vecpar::omp::parallel_make_vector<T>(omp::getDefaultConfig(), mr,
+                                              size, value);
+}
+
+/// new jagged collection whose row i spans [offsets[i], offsets[i + 1]) of
+/// the flattened items, all equal to value. The items are stored back to
+/// back in one buffer (see csr.hpp), which is first touched and filled in
+/// parallel as by parallel_make_vector.
+template <typename T, typename Offsets>
+vecpar::collection::csr_vector<T> &
+parallel_make_jagged_from_offsets(vecpar::config config,
+                                  vecmem::memory_resource &mr,
+                                  const Offsets &offsets,
+                                  const T &value = T()) {
+  auto *result = new vecpar::collection::csr_vector<T>(mr);
+  if (offsets.size() == 0) {
+    result->offsets.assign(1, 0);
+  } else {
+    result->offsets.resize(offsets.size());
+    for (std::size_t row = 0; row < offsets.size(); row++)
+      result->offsets[row] = offsets[row];
+  }
+  internal::first_touch_resize(config, result->values,
+                               result->offsets.back());
+  vecpar::omp::parallel_fill(config, result->values, value);
+  internal::fill_csr_rows(config, *result);
+  return *result;
+}
+
+template <typename T, typename Offsets>
+vecpar::collection::csr_vector<T> &
+parallel_make_jagged_from_offsets(vecmem::memory_resource &mr,
+                                  const Offsets &offsets,
+                                  const T &value = T()) {
+  return vecpar::omp::parallel_make_jagged_from_offsets<T>(
+      omp::getDefaultConfig(), mr, offsets, value);
+}
+
+/// new jagged collection with sizes[i] items in row i, all equal to value
+template <typename T, typename Sizes>
+vecpar::collection::csr_vector<T> &
+parallel_make_jagged(vecpar::config config, vecmem::memory_resource &mr,
+                     const Sizes &sizes, const T &value = T()) {
+  const std::vector<std::size_t> offsets = internal::count_offsets(
+      config, sizes.size(), [&](std::size_t i) { return sizes[i]; });
+  return vecpar::omp::parallel_make_jagged_from_offsets<T>(config, mr, offsets,
+                                                           value);
+}
+
+template <typename T, typename Sizes>
+vecpar::collection::csr_vector<T> &
+parallel_make_jagged(vecmem::memory_resource &mr, const Sizes &sizes,
+                     const T &value = T()) {
+  return vecpar::omp::parallel_make_jagged<T>(omp::getDefaultConfig(), mr,
+                                              sizes, value);
+}
+
+/// AoS -> SoA: the members (e.g. &X::a, &X::b) of every item of aos, as
+/// the fields of a soa_vector, in the order of the members
+template <typename Aos, typename... Members>
+vecpar::soa_vector<
+    typename vecpar::collection::member_pointer_traits<Members>::member_type...> &
+parallel_to_soa(vecpar::config config, vecmem::memory_resource &mr, Aos &aos,
+                Members... members) {
+  auto *result = new vecpar::soa_vector<
+      typename vecpar::collection::member_pointer_traits<Members>::member_type...>(
+      aos.size(), &mr);
+  internal::offload_map(config, aos.size(), [&](int i) {
+    std::apply([&](auto &...fields) { ((fields = aos[i].*members), ...); },
+               (*result)[i].fields());
+  });
+  return *result;
+}
+
+template <typename Aos, typename... Members>
+vecpar::soa_vector<
+    typename vecpar::collection::member_pointer_traits<Members>::member_type...> &
+parallel_to_soa(vecmem::memory_resource &mr, Aos &aos, Members... members) {
+  return vecpar::omp::parallel_to_soa(omp::getDefaultConfig(), mr, aos,
+                                      members...);
+}
+
+/// SoA -> AoS: a vector of the structures of the members, each member taken
+/// from the field at the same position; the other members of the
+/// structures are value-initialized
+template <typename... Fields, typename Member, typename... Members>
+vecmem::vector<
+    typename vecpar::collection::member_pointer_traits<Member>::class_type> &
+parallel_to_aos(vecpar::config config, vecmem::memory_resource &mr,
+                vecpar::soa_vector<Fields...> &soa, Member member,
+                Members... members) {
+  static_assert(sizeof...(Fields) == 1 + sizeof...(Members),
+                "one member per field of the soa_vector");
+  using S =
+      typename vecpar::collection::member_pointer_traits<Member>::class_type;
+  auto *result = new vecmem::vector<S>(soa.size(), &mr);
+  internal::offload_map(config, soa.size(), [&](int i) {
+    S &item = (*result)[i];
+    std::apply(
+        [&](auto &first, auto &...fields) {
+          item.*member = first;
+          ((item.*members = fields), ...);
+        },
+        soa[i].fields());
+  });
+  return *result;
+}
+
+template <typename... Fields, typename Member, typename... Members>
+vecmem::vector<
+    typename vecpar::collection::member_pointer_traits<Member>::class_type> &
+parallel_to_aos(vecmem::memory_resource &mr,
+                vecpar::soa_vector<Fields...> &soa, Member member,
+                Members... members) {
+  return vecpar::omp::parallel_to_aos(omp::getDefaultConfig(), mr, soa,
+                                      member, members...);
+}
+
+/// elementwise maps over jagged collections: the threads share the
+/// flattened element space of the input evenly, whatever the row lengths
+template <class Algorithm,
+          typename R = typename Algorithm::intermediate_result_t, typename T,
+          typename... Rest>
+requires detail::is_map<Algorithm, R, T, Rest...> &&
+    vecpar::collection::Jagged_vector_type<T> &&
+    algorithm::is_elementwise<Algorithm> R &
+    parallel_map(Algorithm &algorithm, vecmem::memory_resource &mr,
+                 vecpar::config config, T &data, Rest &...rest) {
+  internal::check_jagged_shapes(data, rest...);
+  const std::vector<std::size_t> offsets =
+      internal::jagged_offsets(config, data);
+
+  // the result has the shape of the input; the inner vectors are
+  // allocated serially since the memory resource is not required to be
+  // thread-safe
+  R *map_result = new R(data.size(), &mr);
+  for (std::size_t row = 0; row < data.size(); row++)
+    (*map_result)[row].resize(data[row].size());
+
+  internal::offload_jagged(
+      config, offsets, [&](std::size_t row, std::size_t begin, std::size_t end) {
+        for (std::size_t col = begin; col < end; col++)
+          vecpar::detail::call_mapping_function(
+              algorithm, offsets[row] + col, (*map_result)[row][col],
+              data[row][col], get(row, col, rest)...);
+      });
+  return *map_result;
+}
+
+template <class Algorithm,
+          typename R = typename Algorithm::intermediate_result_t, typename T,
+          typename... Rest>
+requires detail::is_map<Algorithm, R, T, Rest...> &&
+    vecpar::collection::Jagged_vector_type<T> &&
+    algorithm::is_elementwise<Algorithm> R &
+    parallel_map(Algorithm &algorithm, vecmem::memory_resource &mr, T &data,
+                 Rest &...rest) {
+  return vecpar::omp::parallel_map(algorithm, mr, omp::getDefaultConfig(), data,
+                                   rest...);
+}
+
+template <class Algorithm,
+          typename R = typename Algorithm::intermediate_result_t, typename T,
+          typename... Rest>
+requires detail::is_mmap<Algorithm, T, Rest...> &&
+    vecpar::collection::Jagged_vector_type<T> &&
+    algorithm::is_elementwise<Algorithm> R &
+    parallel_map(Algorithm &algorithm,
+                 __attribute__((unused)) vecmem::memory_resource &mr,
+                 vecpar::config config, T &data, Rest &...rest) {
+  internal::check_jagged_shapes(data, rest...);
+  const std::vector<std::size_t> offsets =
+      internal::jagged_offsets(config, data);
+  internal::offload_jagged(
+      config, offsets, [&](std::size_t row, std::size_t begin, std::size_t end) {
+        for (std::size_t col = begin; col < end; col++)
+          vecpar::detail::call_mapping_function(algorithm, offsets[row] + col,
+                                                data[row][col],
+                                                get(row, col, rest)...);
+      });
+  return data;
+}
+
+template <class Algorithm,
+          typename R = typename Algorithm::intermediate_result_t, typename T,
+          typename... Rest>
+requires detail::is_mmap<Algorithm, T, Rest...> &&
+    vecpar::collection::Jagged_vector_type<T> &&
+    algorithm::is_elementwise<Algorithm> R &
+    parallel_map(Algorithm &algorithm, vecmem::memory_resource &mr, T &data,
+                 Rest &...rest) {
+  return vecpar::omp::parallel_map(algorithm, mr, omp::getDefaultConfig(), data,
+                                   rest...);
+}
+
+/// elementwise map over a jagged collection with the result stored in
+/// compressed-sparse-row form (one values and one offsets buffer) instead
+/// of one separately allocated inner vector per row
+template <class Algorithm,
+          typename R = typename Algorithm::intermediate_result_t, typename T,
+          typename... Rest>
+requires detail::is_map<Algorithm, R, T, Rest...> &&
+    vecpar::collection::Jagged_vector_type<T> &&
+    vecpar::collection::Jagged_vector_type<R> &&
+    algorithm::is_elementwise<Algorithm>
+        vecpar::collection::csr_vector<vecpar::collection::value_type_t<R>> &
+        parallel_map_csr(Algorithm &algorithm, vecmem::memory_resource &mr,
+                         vecpar::config config, T &data, Rest &...rest) {
+  internal::check_jagged_shapes(data, rest...);
+  using value_t = vecpar::collection::value_type_t<R>;
+  auto *result = new vecpar::collection::csr_vector<value_t>(mr);
+
+  internal::offload_scan(
+      config, data.size(),
+      [&](std::size_t row) -> std::size_t { return data[row].size(); },
+      result->offsets);
+  internal::fill_csr_rows(config, *result);
+
+  internal::offload_jagged(
+      config, result->offsets,
+      [&](std::size_t row, std::size_t begin, std::size_t end) {
+        value_t *out = result->values.data() + result->offsets[row];
+        for (std::size_t col = begin; col < end; col++)
+          vecpar::detail::call_mapping_function(
+              algorithm, result->offsets[row] + col, out[col], data[row][col],
+              get(row, col, rest)...);
+      });
+  return *result;
+}
+
+template <class Algorithm,
+          typename R = typename Algorithm::intermediate_result_t, typename T,
+          typename... Rest>
+requires detail::is_map<Algorithm, R, T, Rest...> &&
+    vecpar::collection::Jagged_vector_type<T> &&
+    vecpar::collection::Jagged_vector_type<R> &&
+    algorithm::is_elementwise<Algorithm>
+        vecpar::collection::csr_vector<vecpar::collection::value_type_t<R>> &
+        parallel_map_csr(Algorithm &algorithm, vecmem::memory_resource &mr,
+                         T &data, Rest &...rest) {
+  return vecpar::omp::parallel_map_csr(algorithm, mr, omp::getDefaultConfig(),
+                                       data, rest...);
+}
+
+/// reduce over a vecmem::vector, a lazy range or a view
 template <typename Algorithm, typename R>
-requires detail::is_reduce<Algorithm, R>
+requires detail::is_reduce<Algorithm, vecpar::collection::declared_t<R>> &&
+    (!vecpar::collection::Jagged_vector_type<R>)
 typename R::value_type &parallel_reduce(Algorithm algorithm,
                                         __attribute__((unused))
                                         vecmem::memory_resource &mr,
@@ -104,20 +541,623 @@ typename R::value_type &parallel_reduce(Algorithm algorithm,
   return *result;
 }
 
-template <typename Algorithm, typename T>
-requires detail::is_filter<Algorithm, T> T &
-parallel_filter(Algorithm algorithm, vecmem::memory_resource &mr, T &data) {
-  T *result = new T(data.size(), &mr);
+/// reduce with a reducer (see vecpar/core/algorithms/reducers.hpp) over a
+/// vecmem::vector, a lazy range or a view; with vecpar::reducers::tuple
+/// several reductions are computed in one pass.
+/// Reducers with a native_op are lowered to an OpenMP reduction clause.
+template <typename Reducer, typename R>
+requires vecpar::reducers::is_reducer<Reducer, typename R::value_type> &&
+    vecpar::collection::Flat_collection<R>
+        vecpar::reducers::result_t<Reducer, typename R::value_type> &
+        parallel_reduce(Reducer reducer,
+                        __attribute__((unused)) vecmem::memory_resource &mr,
+                        vecpar::config config, R &data) {
+  using acc_t = vecpar::reducers::accumulator_t<Reducer, typename R::value_type>;
+  using result_t = vecpar::reducers::result_t<Reducer, typename R::value_type>;
+  constexpr auto op = vecpar::reducers::native<Reducer>();
+
+  result_t *result;
+  if constexpr (op != vecpar::reducers::native_op::none) {
+    result = new result_t(internal::offload_native_reduce<op, Reducer>(
+        config, data.size(),
+        vecpar::reducers::identity<typename R::value_type>(reducer),
+        [&](std::size_t idx) -> acc_t { return data[idx]; }));
+  } else {
+    const acc_t total =
+        internal::offload_accumulate<vecpar::reducers::lanes<Reducer>()>(
+            config, data.size(),
+            vecpar::reducers::identity<typename R::value_type>(reducer),
+            [&](acc_t &acc, std::size_t idx) {
+              vecpar::reducers::accumulate(reducer, acc, data[idx]);
+            },
+            [&](acc_t &acc, const acc_t &partial) {
+              vecpar::reducers::combine(reducer, acc, partial);
+            });
+    result = new result_t(vecpar::reducers::finalize(reducer, total));
+  }
+  return *result;
+}
+
+template <typename Reducer, typename R>
+requires vecpar::reducers::is_reducer<Reducer, typename R::value_type> &&
+    vecpar::collection::Flat_collection<R>
+        vecpar::reducers::result_t<Reducer, typename R::value_type> &
+        parallel_reduce(Reducer reducer, vecmem::memory_resource &mr,
+                        R &data) {
+  return vecpar::omp::parallel_reduce(reducer, mr, omp::getDefaultConfig(),
+                                      data);
+}
+
+/// reduce over all the elements of a jagged collection
+template <typename Algorithm, typename R>
+requires detail::is_reduce<Algorithm, R> &&
+    vecpar::collection::Jagged_vector_type<R>
+        vecpar::collection::value_type_t<R> &parallel_reduce(
+            Algorithm algorithm,
+            __attribute__((unused)) vecmem::memory_resource &mr,
+            vecpar::config config, R &data) {
+  using value_t = vecpar::collection::value_type_t<R>;
+  value_t *result = new value_t();
+
+  const std::vector<std::size_t> offsets =
+      internal::jagged_offsets(config, data);
+  std::vector<value_t> partials(internal::get_num_threads(config));
+  internal::offload_jagged(
+      config, offsets, [&](std::size_t row, std::size_t begin, std::size_t end) {
+        value_t partial = value_t();
+        for (std::size_t col = begin; col < end; col++)
+          algorithm.reducing_function(&partial, data[row][col]);
+        algorithm.reducing_function(&partials[omp_get_thread_num()], partial);
+      });
+
+  for (value_t &partial : partials)
+    algorithm.reducing_function(result, partial);
+  return *result;
+}
+
+template <typename Algorithm, typename R>
+requires detail::is_reduce<Algorithm, R> &&
+    vecpar::collection::Jagged_vector_type<R>
+        vecpar::collection::value_type_t<R> &parallel_reduce(
+            Algorithm algorithm, vecmem::memory_resource &mr, R &data) {
+  return vecpar::omp::parallel_reduce(algorithm, mr, omp::getDefaultConfig(),
+                                      data);
+}
+
+/// reduces every inner vector of a jagged collection to one value; the
+/// i-th item of the result is the reduction of data[i] (empty rows give a
+/// value-initialized item). The rows shared by two or more threads are
+/// combined at the end.
+template <typename Algorithm, typename R>
+requires detail::is_reduce<Algorithm, R> &&
+    vecpar::collection::Jagged_vector_type<R>
+        vecmem::vector<vecpar::collection::value_type_t<R>> &
+        parallel_reduce_rows(Algorithm algorithm, vecmem::memory_resource &mr,
+                             vecpar::config config, R &data) {
+  using value_t = vecpar::collection::value_type_t<R>;
+  auto *result = new vecmem::vector<value_t>(data.size(), &mr);
+
+  const std::vector<std::size_t> offsets =
+      internal::jagged_offsets(config, data);
+  std::vector<std::vector<std::pair<std::size_t, value_t>>> split_rows(
+      internal::get_num_threads(config));
+  internal::offload_jagged(
+      config, offsets, [&](std::size_t row, std::size_t begin, std::size_t end) {
+        value_t partial = value_t();
+        for (std::size_t col = begin; col < end; col++)
+          algorithm.reducing_function(&partial, data[row][col]);
+        if (begin == 0 && end == data[row].size())
+          (*result)[row] = partial;
+        else
+          split_rows[omp_get_thread_num()].emplace_back(row, partial);
+      });
+
+  for (auto &thread_rows : split_rows)
+    for (auto &[row, partial] : thread_rows)
+      algorithm.reducing_function(&(*result)[row], partial);
+  return *result;
+}
+
+template <typename Algorithm, typename R>
+requires detail::is_reduce<Algorithm, R> &&
+    vecpar::collection::Jagged_vector_type<R>
+        vecmem::vector<vecpar::collection::value_type_t<R>> &
+        parallel_reduce_rows(Algorithm algorithm, vecmem::memory_resource &mr,
+                             R &data) {
+  return vecpar::omp::parallel_reduce_rows(algorithm, mr,
+                                           omp::getDefaultConfig(), data);
+}
+
+/// moving reduction over every window of Algorithm::window_size consecutive
+/// elements. Invertible operations use a running update as long as the
+/// window is small compared to the chunk of a thread; otherwise per-block
+/// prefix/suffix tables are used. Both cost O(size) whatever the window.
+template <typename Algorithm, typename R>
+requires detail::is_window_reduce<Algorithm, R> &&
+    vecpar::collection::Vector_type<R> R &
+    parallel_window_reduce(Algorithm algorithm, vecmem::memory_resource &mr,
+                           vecpar::config config, R &data) {
+  constexpr std::size_t window = Algorithm::window_size;
+  R *result =
+      new R(data.size() < window ? 0 : data.size() - window + 1, &mr);
+  if (result->empty())
+    return *result;
+
+  auto add = [&](typename R::value_type *acc, typename R::value_type &item) {
+    algorithm.reducing_function(acc, item);
+  };
+  if constexpr (detail::has_inverse_function<Algorithm, R>) {
+    const std::size_t threads = internal::get_num_threads(config);
+    if (window <= result->size() / threads) {
+      internal::offload_window_running(
+          config, data, window, *result, add,
+          [&](typename R::value_type *acc, typename R::value_type &item) {
+            algorithm.inverse_function(acc, item);
+          });
+      return *result;
+    }
+  }
+  internal::offload_window_blocked(config, data, window, *result, add);
+  return *result;
+}
+
+template <typename Algorithm, typename R>
+requires detail::is_window_reduce<Algorithm, R> &&
+    vecpar::collection::Vector_type<R> R &
+    parallel_window_reduce(Algorithm algorithm, vecmem::memory_resource &mr,
+                           R &data) {
+  return vecpar::omp::parallel_window_reduce(algorithm, mr,
+                                             omp::getDefaultConfig(), data);
+}
+
+/// the k smallest elements according to comp (e.g. std::greater<> for the k
+/// largest ones), sorted; all of them if data has at most k elements
+template <typename Compare, typename R>
+requires vecpar::collection::Vector_type<R>
+    vecmem::vector<typename R::value_type> &
+    parallel_top_k(std::size_t k, Compare comp, vecmem::memory_resource &mr,
+                   vecpar::config config, R &data) {
+  using value_t = typename R::value_type;
+  const std::vector<value_t> best = internal::offload_top_k<value_t>(
+      config, data.size(), k, comp, [&](std::size_t i) { return data[i]; });
+  return *new vecmem::vector<value_t>(best.begin(), best.end(), &mr);
+}
+
+template <typename Compare, typename R>
+requires vecpar::collection::Vector_type<R>
+    vecmem::vector<typename R::value_type> &
+    parallel_top_k(std::size_t k, Compare comp, vecmem::memory_resource &mr,
+                   R &data) {
+  return vecpar::omp::parallel_top_k(k, comp, mr, omp::getDefaultConfig(),
+                                     data);
+}
+
+/// value and position of the minimum; the lowest position if the minimum
+/// occurs several times, index == data.size() for an empty input
+template <typename R>
+requires vecpar::collection::Vector_type<R>
+    vecpar::collection::location<typename R::value_type> &
+    parallel_arg_min(__attribute__((unused)) vecmem::memory_resource &mr,
+                     vecpar::config config, R &data) {
+  using value_t = typename R::value_type;
+  return *new vecpar::collection::location<value_t>(
+      internal::offload_arg_best<value_t>(
+          config, data.size(), std::less<>(),
+          [&](std::size_t i) { return data[i]; }));
+}
+
+template <typename R>
+requires vecpar::collection::Vector_type<R>
+    vecpar::collection::location<typename R::value_type> &
+    parallel_arg_min(vecmem::memory_resource &mr, R &data) {
+  return vecpar::omp::parallel_arg_min(mr, omp::getDefaultConfig(), data);
+}
+
+/// value and position of the maximum; the lowest position if the maximum
+/// occurs several times, index == data.size() for an empty input
+template <typename R>
+requires vecpar::collection::Vector_type<R>
+    vecpar::collection::location<typename R::value_type> &
+    parallel_arg_max(__attribute__((unused)) vecmem::memory_resource &mr,
+                     vecpar::config config, R &data) {
+  using value_t = typename R::value_type;
+  return *new vecpar::collection::location<value_t>(
+      internal::offload_arg_best<value_t>(
+          config, data.size(), std::greater<>(),
+          [&](std::size_t i) { return data[i]; }));
+}
+
+template <typename R>
+requires vecpar::collection::Vector_type<R>
+    vecpar::collection::location<typename R::value_type> &
+    parallel_arg_max(vecmem::memory_resource &mr, R &data) {
+  return vecpar::omp::parallel_arg_max(mr, omp::getDefaultConfig(), data);
+}
+
+/// filter of a vecmem::vector, a lazy range or a view; the result is a
+/// vecmem::vector of the elements that pass the filter
+template <typename Algorithm, typename T,
+          typename R = vecpar::collection::declared_t<T>>
+requires detail::is_filter<Algorithm, R> &&
+    (!vecpar::collection::Jagged_vector_type<T>)
+R &parallel_filter(Algorithm algorithm, vecmem::memory_resource &mr, T &data) {
+  R *result = new R(data.size(), &mr);
   internal::offload_filter(data.size(), result,
-                           [&](int idx, int &result_index, T &local_result) {
-                             if (algorithm.filtering_function(data[idx])) {
-                               local_result[result_index] = data[idx];
+                           [&](int idx, int &result_index, R &local_result) {
+                             // a copy for the elements of a lazy range
+                             decltype(auto) item = data[idx];
+                             if (algorithm.filtering_function(item)) {
+                               local_result[result_index] = item;
                                result_index++;
                              }
                            });
   return *result;
 }
 
+/// row-wise filter for jagged collections: every inner vector keeps (in
+/// order) its elements that pass the filter. The flags are computed over the
+/// flattened element space and the new row offsets are taken from a scan.
+template <typename Algorithm, typename T>
+requires detail::is_filter<Algorithm, T> &&
+    vecpar::collection::Jagged_vector_type<T> T &
+    parallel_filter(Algorithm algorithm, vecmem::memory_resource &mr,
+                    vecpar::config config, T &data) {
+  const std::vector<std::size_t> offsets =
+      internal::jagged_offsets(config, data);
+
+  std::vector<char> keep(offsets.back());
+  internal::offload_jagged(
+      config, offsets, [&](std::size_t row, std::size_t begin, std::size_t end) {
+        for (std::size_t col = begin; col < end; col++)
+          keep[offsets[row] + col] =
+              algorithm.filtering_function(data[row][col]);
+      });
+
+  std::vector<std::size_t> positions;
+  internal::offload_scan(
+      config, keep.size(),
+      [&](std::size_t i) -> std::size_t { return keep[i]; }, positions);
+
+  // the inner vectors are allocated serially since
+  // the memory resource is not required to be thread-safe
+  T *result = new T(data.size(), &mr);
+  for (std::size_t row = 0; row < data.size(); row++)
+    (*result)[row].resize(positions[offsets[row + 1]] -
+                          positions[offsets[row]]);
+
+  internal::offload_jagged(
+      config, offsets, [&](std::size_t row, std::size_t begin, std::size_t end) {
+        const std::size_t row_begin = positions[offsets[row]];
+        for (std::size_t col = begin; col < end; col++) {
+          const std::size_t flat = offsets[row] + col;
+          if (keep[flat])
+            (*result)[row][positions[flat] - row_begin] = data[row][col];
+        }
+      });
+  return *result;
+}
+
+template <typename Algorithm, typename T>
+requires detail::is_filter<Algorithm, T> &&
+    vecpar::collection::Jagged_vector_type<T> T &
+    parallel_filter(Algorithm algorithm, vecmem::memory_resource &mr,
+                    T &data) {
+  return vecpar::omp::parallel_filter(algorithm, mr, omp::getDefaultConfig(),
+                                      data);
+}
+
+/// filter which returns the (ordered) positions of the elements that pass
+/// the filter instead of copies of them
+template <typename Index = std::uint32_t, typename Algorithm, typename T>
+requires detail::is_filter<Algorithm, T> vecpar::collection::index_vector<Index>
+&parallel_filter_indices(Algorithm algorithm, vecmem::memory_resource &mr,
+                         vecpar::config config, T &data) {
+  auto *result = new vecpar::collection::index_vector<Index>(&mr);
+  internal::offload_select(config, data.size(), *result, [&](std::size_t idx) {
+    return algorithm.filtering_function(data[idx]);
+  });
+  return *result;
+}
+
+template <typename Index = std::uint32_t, typename Algorithm, typename T>
+requires detail::is_filter<Algorithm, T> vecpar::collection::index_vector<Index>
+&parallel_filter_indices(Algorithm algorithm, vecmem::memory_resource &mr,
+                         T &data) {
+  return vecpar::omp::parallel_filter_indices<Index>(
+      algorithm, mr, omp::getDefaultConfig(), data);
+}
+
+/// filter which returns one bit per element of the input collection
+template <typename Algorithm, typename T>
+requires detail::is_filter<Algorithm, T> vecpar::collection::bitmask &
+parallel_filter_bitmask(Algorithm algorithm, vecmem::memory_resource &mr,
+                        vecpar::config config, T &data) {
+  auto *result = new vecpar::collection::bitmask(
+      vecpar::collection::bitmask_words(data.size()), &mr);
+  internal::offload_mask(config, data.size(), *result, [&](std::size_t idx) {
+    return algorithm.filtering_function(data[idx]);
+  });
+  return *result;
+}
+
+template <typename Algorithm, typename T>
+requires detail::is_filter<Algorithm, T> vecpar::collection::bitmask &
+parallel_filter_bitmask(Algorithm algorithm, vecmem::memory_resource &mr,
+                        T &data) {
+  return vecpar::omp::parallel_filter_bitmask(algorithm, mr,
+                                              omp::getDefaultConfig(), data);
+}
+
+/// filter which keeps the surviving elements at the front of the (mutable)
+/// input collection and resizes it, without allocating a second collection
+template <typename Algorithm, typename T>
+requires detail::is_filter<Algorithm, T> T &
+parallel_filter_in_place(Algorithm algorithm,
+                         __attribute__((unused)) vecmem::memory_resource &mr,
+                         vecpar::config config, T &data) {
+  internal::offload_compact(config, data, [&](std::size_t idx) {
+    return algorithm.filtering_function(data[idx]);
+  });
+  return data;
+}
+
+template <typename Algorithm, typename T>
+requires detail::is_filter<Algorithm, T> T &
+parallel_filter_in_place(Algorithm algorithm, vecmem::memory_resource &mr,
+                         T &data) {
+  return vecpar::omp::parallel_filter_in_place(algorithm, mr,
+                                               omp::getDefaultConfig(), data);
+}
+
+/// lowest position of an element which passes the filter, or data.size()
+/// if there is none; the scan stops early once a match is found
+template <typename Algorithm, typename T>
+requires detail::is_filter<Algorithm, T> &&
+    vecpar::collection::Vector_type<T> std::size_t
+    parallel_find_first(Algorithm algorithm, vecpar::config config, T &data) {
+  return internal::offload_find_first(config, data.size(), [&](std::size_t i) {
+    return algorithm.filtering_function(data[i]);
+  });
+}
+
+template <typename Algorithm, typename T>
+requires detail::is_filter<Algorithm, T> &&
+    vecpar::collection::Vector_type<T> std::size_t
+    parallel_find_first(Algorithm algorithm, T &data) {
+  return vecpar::omp::parallel_find_first(algorithm, omp::getDefaultConfig(),
+                                          data);
+}
+
+/// true if at least one element passes the filter
+template <typename Algorithm, typename T>
+requires detail::is_filter<Algorithm, T> &&
+    vecpar::collection::Vector_type<T>
+bool parallel_any_of(Algorithm algorithm, vecpar::config config, T &data) {
+  return vecpar::omp::parallel_find_first(algorithm, config, data) <
+         data.size();
+}
+
+template <typename Algorithm, typename T>
+requires detail::is_filter<Algorithm, T> &&
+    vecpar::collection::Vector_type<T>
+bool parallel_any_of(Algorithm algorithm, T &data) {
+  return vecpar::omp::parallel_any_of(algorithm, omp::getDefaultConfig(), data);
+}
+
+/// true if every element passes the filter; stops at the first failure
+template <typename Algorithm, typename T>
+requires detail::is_filter<Algorithm, T> &&
+    vecpar::collection::Vector_type<T>
+bool parallel_all_of(Algorithm algorithm, vecpar::config config, T &data) {
+  return internal::offload_find_first(config, data.size(), [&](std::size_t i) {
+           return !algorithm.filtering_function(data[i]);
+         }) == data.size();
+}
+
+template <typename Algorithm, typename T>
+requires detail::is_filter<Algorithm, T> &&
+    vecpar::collection::Vector_type<T>
+bool parallel_all_of(Algorithm algorithm, T &data) {
+  return vecpar::omp::parallel_all_of(algorithm, omp::getDefaultConfig(), data);
+}
+
+/// number of elements which pass the filter (nothing is allocated)
+template <typename Algorithm, typename T>
+requires detail::is_filter<Algorithm, T> &&
+    vecpar::collection::Vector_type<T> std::size_t
+    parallel_count_if(Algorithm algorithm, vecpar::config config, T &data) {
+  return internal::offload_count_if(config, data.size(), [&](std::size_t i) {
+    return algorithm.filtering_function(data[i]);
+  });
+}
+
+template <typename Algorithm, typename T>
+requires detail::is_filter<Algorithm, T> &&
+    vecpar::collection::Vector_type<T> std::size_t
+    parallel_count_if(Algorithm algorithm, T &data) {
+  return vecpar::omp::parallel_count_if(algorithm, omp::getDefaultConfig(),
+                                        data);
+}
+
+/// map which runs only over the elements listed in the selection;
+/// the i-th item of the result is computed from data[selection[i]]
+template <class Algorithm,
+          typename R = typename Algorithm::intermediate_result_t,
+          typename Index, typename T, typename... Rest>
+requires detail::is_map<Algorithm, R, T, Rest...> R &
+parallel_map_selected(Algorithm &algorithm, vecmem::memory_resource &mr,
+                      vecpar::config config,
+                      const vecpar::collection::index_vector<Index> &selection,
+                      T &data, Rest &...rest) {
+  R *map_result = new R(selection.size(), &mr);
+  internal::offload_map_scratch(
+      config, selection.size(), algorithm, [&](int i, vecpar::scratch &s) {
+        const int idx = static_cast<int>(selection[i]);
+        vecpar::detail::call_mapping_function(algorithm, idx, s,
+                                              (*map_result)[i], data[idx],
+                                              get(idx, rest)...);
+      });
+  return *map_result;
+}
+
+/// mmap which updates in place only the elements listed in the selection
+template <class Algorithm,
+          typename R = typename Algorithm::intermediate_result_t,
+          typename Index, typename T, typename... Rest>
+requires detail::is_mmap<Algorithm, T, Rest...> T &
+parallel_map_selected(Algorithm &algorithm,
+                      __attribute__((unused)) vecmem::memory_resource &mr,
+                      vecpar::config config,
+                      const vecpar::collection::index_vector<Index> &selection,
+                      T &data, Rest &...rest) {
+  internal::offload_map_scratch(
+      config, selection.size(), algorithm, [&](int i, vecpar::scratch &s) {
+        const int idx = static_cast<int>(selection[i]);
+        vecpar::detail::call_mapping_function(algorithm, idx, s, data[idx],
+                                              get(idx, rest)...);
+      });
+  return data;
+}
+
+template <class Algorithm,
+          typename R = typename Algorithm::intermediate_result_t,
+          typename Index, typename T, typename... Rest>
+R &parallel_map_selected(
+    Algorithm &algorithm, vecmem::memory_resource &mr,
+    const vecpar::collection::index_vector<Index> &selection, T &data,
+    Rest &...rest) {
+  return vecpar::omp::parallel_map_selected(
+      algorithm, mr, omp::getDefaultConfig(), selection, data, rest...);
+}
+
+/// mmap which updates in place only the elements whose bit is set in the
+/// mask; the backend picks the dense or the sparse strategy from the share
+/// of set bits (see internal::offload_masked). Throws std::length_error if
+/// the mask has fewer words than the collection needs.
+template <class Algorithm, typename T, typename... Rest>
+requires detail::is_mmap<Algorithm, T, Rest...> T &
+parallel_map_masked(Algorithm &algorithm,
+                    __attribute__((unused)) vecmem::memory_resource &mr,
+                    vecpar::config config,
+                    const vecpar::collection::bitmask &mask, T &data,
+                    Rest &...rest) {
+  if (mask.size() < vecpar::collection::bitmask_words(data.size()))
+    throw std::length_error("the mask is smaller than the collection");
+  internal::offload_masked(config, mask, data.size(), [&](std::size_t i) {
+    const int idx = static_cast<int>(i);
+    vecpar::detail::call_mapping_function(algorithm, idx, data[idx],
+                                          get(idx, rest)...);
+  });
+  return data;
+}
+
+template <class Algorithm, typename T, typename... Rest>
+requires detail::is_mmap<Algorithm, T, Rest...> T &
+parallel_map_masked(Algorithm &algorithm, vecmem::memory_resource &mr,
+                    const vecpar::collection::bitmask &mask, T &data,
+                    Rest &...rest) {
+  return vecpar::omp::parallel_map_masked(
+      algorithm, mr, omp::getDefaultConfig(), mask, data, rest...);
+}
+
+/// mmap which updates in place only the elements which pass the filter;
+/// the outcome of the filter is first stored as a temporary bitmask, so
+/// the same density-based strategy as for parallel_map_masked is used
+template <class Algorithm, class Filter, typename T, typename... Rest>
+requires detail::is_mmap<Algorithm, T, Rest...> &&
+    detail::is_filter<Filter, T> T &
+    parallel_map_where(Algorithm &algorithm, Filter filter,
+                       vecmem::memory_resource &mr, vecpar::config config,
+                       T &data, Rest &...rest) {
+  vecpar::collection::bitmask mask(
+      vecpar::collection::bitmask_words(data.size()), &mr);
+  internal::offload_mask(config, data.size(), mask, [&](std::size_t idx) {
+    return filter.filtering_function(data[idx]);
+  });
+  return vecpar::omp::parallel_map_masked(algorithm, mr, config, mask, data,
+                                          rest...);
+}
+
+template <class Algorithm, class Filter, typename T, typename... Rest>
+requires detail::is_mmap<Algorithm, T, Rest...> &&
+    detail::is_filter<Filter, T> T &
+    parallel_map_where(Algorithm &algorithm, Filter filter,
+                       vecmem::memory_resource &mr, T &data, Rest &...rest) {
+  return vecpar::omp::parallel_map_where(
+      algorithm, filter, mr, omp::getDefaultConfig(), data, rest...);
+}
+
+/// flat-map: counting pass, exclusive scan over the counts and emitting
+/// pass, writing directly into an exactly-sized flat result
+template <class Algorithm, typename R = typename Algorithm::result_t,
+          typename T, typename... Rest>
+requires detail::is_flat_map<Algorithm, R, T, Rest...> R &
+parallel_flat_map(Algorithm &algorithm, vecmem::memory_resource &mr,
+                  vecpar::config config, T &data, Rest &...rest) {
+  const std::vector<std::size_t> offsets =
+      internal::count_offsets(config, data.size(), [&](std::size_t i) {
+        const int idx = static_cast<int>(i);
+        return algorithm.count_function(data[idx], get(idx, rest)...);
+      });
+
+  R *result = new R(offsets.back(), &mr);
+  internal::offload_map(config, data.size(), [&](int idx) {
+    algorithm.emit_function(
+        idx,
+        std::span(result->data() + offsets[idx],
+                  offsets[idx + 1] - offsets[idx]),
+        data[idx], get(idx, rest)...);
+  });
+  return *result;
+}
+
+template <class Algorithm, typename R = typename Algorithm::result_t,
+          typename T, typename... Rest>
+requires detail::is_flat_map<Algorithm, R, T, Rest...> R &
+parallel_flat_map(Algorithm &algorithm, vecmem::memory_resource &mr, T &data,
+                  Rest &...rest) {
+  return vecpar::omp::parallel_flat_map(algorithm, mr, omp::getDefaultConfig(),
+                                        data, rest...);
+}
+
+/// flat-map which keeps the output items grouped by input: the i-th row of
+/// the result holds the items emitted for data[i]. The items are emitted
+/// directly into the values of a csr_vector, whose offsets are the scan of
+/// the counts, so no inner vector is allocated.
+template <class Algorithm, typename R = typename Algorithm::result_t,
+          typename T, typename... Rest>
+requires detail::is_flat_map<Algorithm, R, T, Rest...>
+    vecpar::collection::csr_vector<typename R::value_type> &
+    parallel_flat_map_jagged(Algorithm &algorithm, vecmem::memory_resource &mr,
+                             vecpar::config config, T &data, Rest &...rest) {
+  auto *result =
+      new vecpar::collection::csr_vector<typename R::value_type>(mr);
+  internal::count_offsets(
+      config, data.size(),
+      [&](std::size_t i) {
+        const int idx = static_cast<int>(i);
+        return algorithm.count_function(data[idx], get(idx, rest)...);
+      },
+      result->offsets);
+  internal::fill_csr_rows(config, *result);
+
+  internal::offload_map(config, data.size(), [&](int idx) {
+    algorithm.emit_function(idx, (*result)[idx], data[idx],
+                            get(idx, rest)...);
+  });
+  return *result;
+}
+
+template <class Algorithm, typename R = typename Algorithm::result_t,
+          typename T, typename... Rest>
+requires detail::is_flat_map<Algorithm, R, T, Rest...>
+    vecpar::collection::csr_vector<typename R::value_type> &
+    parallel_flat_map_jagged(Algorithm &algorithm, vecmem::memory_resource &mr,
+                             T &data, Rest &...rest) {
+  return vecpar::omp::parallel_flat_map_jagged(
+      algorithm, mr, omp::getDefaultConfig(), data, rest...);
+}
+
 /// specific composed implementations
 template <class Algorithm, typename Result, typename R, typename T,
           typename... Arguments>
@@ -138,6 +1178,166 @@ Result &parallel_map_reduce(Algorithm &algorithm, vecmem::memory_resource &mr,
       vecpar::omp::parallel_map(algorithm, mr, config, data, args...));
 }
 
+/// map-reduce with a reducer: every element is mapped into a temporary and
+/// accumulated right away, without an intermediate collection
+template <class Algorithm, typename Reducer,
+          typename R = typename Algorithm::intermediate_result_t, typename T,
+          typename... Arguments>
+requires(detail::is_map<Algorithm, R, T, Arguments...> ||
+         detail::is_mmap<Algorithm, T, Arguments...>) &&
+    vecpar::reducers::is_reducer<Reducer, typename R::value_type>
+        vecpar::reducers::result_t<Reducer, typename R::value_type> &
+        parallel_map_reduce(Algorithm &algorithm, Reducer reducer,
+                            __attribute__((unused)) vecmem::memory_resource &mr,
+                            vecpar::config config, T &data,
+                            Arguments &...args) {
+  using acc_t = vecpar::reducers::accumulator_t<Reducer, typename R::value_type>;
+  using result_t = vecpar::reducers::result_t<Reducer, typename R::value_type>;
+  constexpr auto op = vecpar::reducers::native<Reducer>();
+
+  auto map = [&](std::size_t i) {
+    return internal::map_item<typename R::value_type,
+                              detail::is_mmap<Algorithm, T, Arguments...>>(
+        algorithm, i, data, args...);
+  };
+
+  result_t *result;
+  if constexpr (op != vecpar::reducers::native_op::none) {
+    result = new result_t(internal::offload_native_reduce<op, Reducer>(
+        config, data.size(),
+        vecpar::reducers::identity<typename R::value_type>(reducer),
+        [&](std::size_t i) -> acc_t { return map(i); }));
+  } else {
+    const acc_t total =
+        internal::offload_accumulate<vecpar::reducers::lanes<Reducer>()>(
+            config, data.size(),
+            vecpar::reducers::identity<typename R::value_type>(reducer),
+            [&](acc_t &acc, std::size_t i) {
+              vecpar::reducers::accumulate(reducer, acc, map(i));
+            },
+            [&](acc_t &acc, const acc_t &partial) {
+              vecpar::reducers::combine(reducer, acc, partial);
+            });
+    result = new result_t(vecpar::reducers::finalize(reducer, total));
+  }
+  return *result;
+}
+
+template <class Algorithm, typename Reducer,
+          typename R = typename Algorithm::intermediate_result_t, typename T,
+          typename... Arguments>
+requires(detail::is_map<Algorithm, R, T, Arguments...> ||
+         detail::is_mmap<Algorithm, T, Arguments...>) &&
+    vecpar::reducers::is_reducer<Reducer, typename R::value_type>
+        vecpar::reducers::result_t<Reducer, typename R::value_type> &
+        parallel_map_reduce(Algorithm &algorithm, Reducer reducer,
+                            vecmem::memory_resource &mr, T &data,
+                            Arguments &...args) {
+  return vecpar::omp::parallel_map_reduce(
+      algorithm, reducer, mr, omp::getDefaultConfig(), data, args...);
+}
+
+/// top-k over the items of a map, without an intermediate collection
+template <class Algorithm, typename Compare,
+          typename R = typename Algorithm::intermediate_result_t, typename T,
+          typename... Arguments>
+requires detail::is_map<Algorithm, R, T, Arguments...> ||
+    detail::is_mmap<Algorithm, T, Arguments...>
+        vecmem::vector<typename R::value_type> &
+        parallel_map_top_k(Algorithm &algorithm, std::size_t k, Compare comp,
+                           vecmem::memory_resource &mr, vecpar::config config,
+                           T &data, Arguments &...args) {
+  using value_t = typename R::value_type;
+  const std::vector<value_t> best = internal::offload_top_k<value_t>(
+      config, data.size(), k, comp, [&](std::size_t i) {
+        return internal::map_item<value_t,
+                                  detail::is_mmap<Algorithm, T, Arguments...>>(
+            algorithm, i, data, args...);
+      });
+  return *new vecmem::vector<value_t>(best.begin(), best.end(), &mr);
+}
+
+template <class Algorithm, typename Compare,
+          typename R = typename Algorithm::intermediate_result_t, typename T,
+          typename... Arguments>
+requires detail::is_map<Algorithm, R, T, Arguments...> ||
+    detail::is_mmap<Algorithm, T, Arguments...>
+        vecmem::vector<typename R::value_type> &
+        parallel_map_top_k(Algorithm &algorithm, std::size_t k, Compare comp,
+                           vecmem::memory_resource &mr, T &data,
+                           Arguments &...args) {
+  return vecpar::omp::parallel_map_top_k(
+      algorithm, k, comp, mr, omp::getDefaultConfig(), data, args...);
+}
+
+/// arg-min over the items of a map, without an intermediate collection
+template <class Algorithm,
+          typename R = typename Algorithm::intermediate_result_t, typename T,
+          typename... Arguments>
+requires detail::is_map<Algorithm, R, T, Arguments...> ||
+    detail::is_mmap<Algorithm, T, Arguments...>
+        vecpar::collection::location<typename R::value_type> &
+        parallel_map_arg_min(Algorithm &algorithm,
+                             __attribute__((unused))
+                             vecmem::memory_resource &mr,
+                             vecpar::config config, T &data,
+                             Arguments &...args) {
+  using value_t = typename R::value_type;
+  return *new vecpar::collection::location<value_t>(
+      internal::offload_arg_best<value_t>(
+          config, data.size(), std::less<>(), [&](std::size_t i) {
+            return internal::map_item<
+                value_t, detail::is_mmap<Algorithm, T, Arguments...>>(
+                algorithm, i, data, args...);
+          }));
+}
+
+template <class Algorithm,
+          typename R = typename Algorithm::intermediate_result_t, typename T,
+          typename... Arguments>
+requires detail::is_map<Algorithm, R, T, Arguments...> ||
+    detail::is_mmap<Algorithm, T, Arguments...>
+        vecpar::collection::location<typename R::value_type> &
+        parallel_map_arg_min(Algorithm &algorithm, vecmem::memory_resource &mr,
+                             T &data, Arguments &...args) {
+  return vecpar::omp::parallel_map_arg_min(
+      algorithm, mr, omp::getDefaultConfig(), data, args...);
+}
+
+/// arg-max over the items of a map, without an intermediate collection
+template <class Algorithm,
+          typename R = typename Algorithm::intermediate_result_t, typename T,
+          typename... Arguments>
+requires detail::is_map<Algorithm, R, T, Arguments...> ||
+    detail::is_mmap<Algorithm, T, Arguments...>
+        vecpar::collection::location<typename R::value_type> &
+        parallel_map_arg_max(Algorithm &algorithm,
+                             __attribute__((unused))
+                             vecmem::memory_resource &mr,
+                             vecpar::config config, T &data,
+                             Arguments &...args) {
+  using value_t = typename R::value_type;
+  return *new vecpar::collection::location<value_t>(
+      internal::offload_arg_best<value_t>(
+          config, data.size(), std::greater<>(), [&](std::size_t i) {
+            return internal::map_item<
+                value_t, detail::is_mmap<Algorithm, T, Arguments...>>(
+                algorithm, i, data, args...);
+          }));
+}
+
+template <class Algorithm,
+          typename R = typename Algorithm::intermediate_result_t, typename T,
+          typename... Arguments>
+requires detail::is_map<Algorithm, R, T, Arguments...> ||
+    detail::is_mmap<Algorithm, T, Arguments...>
+        vecpar::collection::location<typename R::value_type> &
+        parallel_map_arg_max(Algorithm &algorithm, vecmem::memory_resource &mr,
+                             T &data, Arguments &...args) {
+  return vecpar::omp::parallel_map_arg_max(
+      algorithm, mr, omp::getDefaultConfig(), data, args...);
+}
+
 template <class Algorithm, typename R, typename T, typename... Arguments>
 R &parallel_map_filter(Algorithm &algorithm, vecmem::memory_resource &mr,
                        vecpar::config config, T &data, Arguments &...args) {
@@ -156,6 +1356,112 @@ R &parallel_map_filter(Algorithm &algorithm, vecmem::memory_resource &mr,
       algorithm, mr, omp::getDefaultConfig(), data, args...);
 }
 
+/// map-filter which returns the positions of the elements that pass the
+/// filter. For map-filter algorithms the mapped items are only kept in a
+/// temporary (no intermediate collection is allocated) and the indices refer
+/// to the input collection; for mmap-filter algorithms the input collection
+/// is updated in place as usual.
+template <typename Index = std::uint32_t, class Algorithm,
+          typename R = typename Algorithm::result_t, typename T,
+          typename... Arguments>
+requires algorithm::is_map_filter<Algorithm, R, T, Arguments...> ||
+    algorithm::is_mmap_filter<Algorithm, T, Arguments...>
+        vecpar::collection::index_vector<Index> &parallel_map_filter_indices(
+            Algorithm &algorithm, vecmem::memory_resource &mr,
+            vecpar::config config, T &data, Arguments &...args) {
+  auto *result = new vecpar::collection::index_vector<Index>(&mr);
+  internal::offload_select(config, data.size(), *result, [&](std::size_t i) {
+    const int idx = static_cast<int>(i);
+    if constexpr (algorithm::is_mmap_filter<Algorithm, T, Arguments...>) {
+      vecpar::detail::call_mapping_function(algorithm, idx, data[idx],
+                                            get(idx, args)...);
+      return algorithm.filtering_function(data[idx]);
+    } else {
+      typename R::value_type item{};
+      vecpar::detail::call_mapping_function(algorithm, idx, item, data[idx],
+                                            get(idx, args)...);
+      return algorithm.filtering_function(item);
+    }
+  });
+  return *result;
+}
+
+template <typename Index = std::uint32_t, class Algorithm,
+          typename R = typename Algorithm::result_t, typename T,
+          typename... Arguments>
+requires algorithm::is_map_filter<Algorithm, R, T, Arguments...> ||
+    algorithm::is_mmap_filter<Algorithm, T, Arguments...>
+        vecpar::collection::index_vector<Index> &parallel_map_filter_indices(
+            Algorithm &algorithm, vecmem::memory_resource &mr, T &data,
+            Arguments &...args) {
+  return vecpar::omp::parallel_map_filter_indices<Index>(
+      algorithm, mr, omp::getDefaultConfig(), data, args...);
+}
+
+/// same as parallel_map_filter_indices, but returns one bit per input element
+template <class Algorithm, typename R = typename Algorithm::result_t,
+          typename T, typename... Arguments>
+requires algorithm::is_map_filter<Algorithm, R, T, Arguments...> ||
+    algorithm::is_mmap_filter<Algorithm, T, Arguments...>
+        vecpar::collection::bitmask &parallel_map_filter_bitmask(
+            Algorithm &algorithm, vecmem::memory_resource &mr,
+            vecpar::config config, T &data, Arguments &...args) {
+  auto *result = new vecpar::collection::bitmask(
+      vecpar::collection::bitmask_words(data.size()), &mr);
+  internal::offload_mask(config, data.size(), *result, [&](std::size_t i) {
+    const int idx = static_cast<int>(i);
+    if constexpr (algorithm::is_mmap_filter<Algorithm, T, Arguments...>) {
+      vecpar::detail::call_mapping_function(algorithm, idx, data[idx],
+                                            get(idx, args)...);
+      return algorithm.filtering_function(data[idx]);
+    } else {
+      typename R::value_type item{};
+      vecpar::detail::call_mapping_function(algorithm, idx, item, data[idx],
+                                            get(idx, args)...);
+      return algorithm.filtering_function(item);
+    }
+  });
+  return *result;
+}
+
+template <class Algorithm, typename R = typename Algorithm::result_t,
+          typename T, typename... Arguments>
+requires algorithm::is_map_filter<Algorithm, R, T, Arguments...> ||
+    algorithm::is_mmap_filter<Algorithm, T, Arguments...>
+        vecpar::collection::bitmask &parallel_map_filter_bitmask(
+            Algorithm &algorithm, vecmem::memory_resource &mr, T &data,
+            Arguments &...args) {
+  return vecpar::omp::parallel_map_filter_bitmask(
+      algorithm, mr, omp::getDefaultConfig(), data, args...);
+}
+
+/// mmap-filter in a single pass: every element is mapped in place and the
+/// survivors are compacted to the front of the input collection, which is
+/// then resized. The memory footprint stays at the size of the input.
+template <class Algorithm, typename T, typename... Arguments>
+requires algorithm::is_mmap_filter<Algorithm, T, Arguments...> T &
+parallel_map_filter_in_place(Algorithm &algorithm,
+                             __attribute__((unused))
+                             vecmem::memory_resource &mr,
+                             vecpar::config config, T &data,
+                             Arguments &...args) {
+  internal::offload_compact(config, data, [&](std::size_t i) {
+    const int idx = static_cast<int>(i);
+    vecpar::detail::call_mapping_function(algorithm, idx, data[idx],
+                                          get(idx, args)...);
+    return algorithm.filtering_function(data[idx]);
+  });
+  return data;
+}
+
+template <class Algorithm, typename T, typename... Arguments>
+requires algorithm::is_mmap_filter<Algorithm, T, Arguments...> T &
+parallel_map_filter_in_place(Algorithm &algorithm, vecmem::memory_resource &mr,
+                             T &data, Arguments &...args) {
+  return vecpar::omp::parallel_map_filter_in_place(
+      algorithm, mr, omp::getDefaultConfig(), data, args...);
+}
+
 template <class MemoryResource, class Algorithm,
           typename Result = typename Algorithm::result_t,
           typename R = typename Algorithm::intermediate_result_t, typename T,
@@ -209,5 +1515,69 @@ requires algorithm::is_map_filter<Algorithm, R, T, Arguments...> ||
   return vecpar::omp::parallel_map_filter<Algorithm, R, T, Arguments...>(
       algorithm, mr, omp::getDefaultConfig(), data, args...);
 }
+
+/// lazy ranges and views are usually created in the call itself; these
+/// overloads take the inputs by forwarding reference and pass them on as
+/// lvalues to the overloads above
+template <class Algorithm, typename... Inputs>
+requires internal::has_temporary<Inputs...> &&
+    requires(Algorithm &algorithm, vecmem::memory_resource &mr,
+             Inputs &...inputs) {
+  vecpar::omp::parallel_map(algorithm, mr, inputs...);
+}
+decltype(auto) parallel_map(Algorithm &algorithm, vecmem::memory_resource &mr,
+                            Inputs &&...inputs) {
+  return vecpar::omp::parallel_map(algorithm, mr, inputs...);
+}
+
+template <class Algorithm, typename... Inputs>
+requires internal::has_temporary<Inputs...> &&
+    requires(Algorithm &algorithm, Inputs &...inputs) {
+  vecpar::omp::parallel_map_reduce(algorithm, inputs...);
+}
+decltype(auto) parallel_map_reduce(Algorithm &algorithm, Inputs &&...inputs) {
+  return vecpar::omp::parallel_map_reduce(algorithm, inputs...);
+}
+
+template <class Algorithm, typename... Inputs>
+requires internal::has_temporary<Inputs...> &&
+    requires(Algorithm &algorithm, Inputs &...inputs) {
+  vecpar::omp::parallel_map_filter(algorithm, inputs...);
+}
+decltype(auto) parallel_map_filter(Algorithm &algorithm, Inputs &&...inputs) {
+  return vecpar::omp::parallel_map_filter(algorithm, inputs...);
+}
+
+template <typename Algorithm, typename... Inputs>
+requires internal::has_temporary<Inputs...> &&
+    requires(Algorithm algorithm, vecmem::memory_resource &mr,
+             Inputs &...inputs) {
+  vecpar::omp::parallel_reduce(algorithm, mr, inputs...);
+}
+decltype(auto) parallel_reduce(Algorithm algorithm, vecmem::memory_resource &mr,
+                               Inputs &&...inputs) {
+  return vecpar::omp::parallel_reduce(algorithm, mr, inputs...);
+}
+
+template <typename Algorithm, typename... Inputs>
+requires internal::has_temporary<Inputs...> &&
+    requires(Algorithm algorithm, vecmem::memory_resource &mr,
+             Inputs &...inputs) {
+  vecpar::omp::parallel_filter(algorithm, mr, inputs...);
+}
+decltype(auto) parallel_filter(Algorithm algorithm, vecmem::memory_resource &mr,
+                               Inputs &&...inputs) {
+  return vecpar::omp::parallel_filter(algorithm, mr, inputs...);
+}
+
+template <class MemoryResource, class Algorithm, typename... Inputs>
+requires internal::has_temporary<Inputs...> &&
+    requires(Algorithm algorithm, MemoryResource &mr, Inputs &...inputs) {
+  vecpar::omp::parallel_algorithm(algorithm, mr, inputs...);
+}
+decltype(auto) parallel_algorithm(Algorithm algorithm, MemoryResource &mr,
+                                  Inputs &&...inputs) {
+  return vecpar::omp::parallel_algorithm(algorithm, mr, inputs...);
+}
 } // namespace vecpar::omp
 #endif // VECPAR_OMP_PARALLELIZATION_HPP
@@ -5,6 +5,7 @@
 #include <cmath>
 #include <cstddef>
 #include <stdio.h>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
@@ -22,18 +23,95 @@
 #include "vecpar/core/definitions/config.hpp"
 
 #include "vecpar/core/definitions/helper.hpp"
+#include "vecpar/omp/omp_parallelization.hpp"
 
 #define BLOCK_SIZE 32
 
 namespace vecpar::ompt {
 
+/// a collection of a map over several collections, copied to the device
+template <typename T> struct device_collection {
+  T *ptr;
+};
+
+/// argument of a map as passed to the target region: a collection is
+/// copied to the device, any other argument is copied into the region
+template <bool Collection, typename P>
+auto to_device_arg(P &param, std::size_t size) {
+  if constexpr (Collection) {
+    using value_t = value_type_t<std::remove_const_t<P>>;
+    const int device = omp_get_default_device();
+    auto *d = static_cast<value_t *>(
+        omp_target_alloc(size * sizeof(value_t), device));
+    omp_target_memcpy(d, param.data(), size * sizeof(value_t), 0, 0, device,
+                      omp_get_initial_device());
+    return device_collection<value_t>{d};
+  } else {
+    return param;
+  }
+}
+
+/// the arguments after the first collection of a map, as passed to the
+/// target region: the Collections leading ones are copied to the device
+template <std::size_t Collections, typename... Rest>
+auto to_device(std::size_t size, Rest &...rest) {
+  return [&]<std::size_t... I>(std::index_sequence<I...>) {
+    return std::make_tuple(to_device_arg<(I < Collections)>(rest, size)...);
+  }(std::index_sequence_for<Rest...>{});
+}
+
+/// frees the device copies made by to_device
+template <typename... Args> void free_device(std::tuple<Args...> &args) {
+  std::apply(
+      [](auto &...arg) {
+        (
+            [&](auto &a) {
+              if constexpr (requires { a.ptr; })
+                omp_target_free(a.ptr, omp_get_default_device());
+            }(arg),
+            ...);
+      },
+      args);
+}
+
+/// item idx of an argument in the target region
+template <typename T>
+T &device_item(int idx, device_collection<T> &collection) {
+  return collection.ptr[idx];
+}
+
+template <typename P> P &device_item(int, P &param) { return param; }
+
+/// calls the mapping function on the device with the items of the first
+/// collection(s) followed by the arguments made by to_device
+template <typename Algorithm, typename Tuple, std::size_t... I,
+          typename... Items>
+void call_on_device(Algorithm &algorithm, int idx, Tuple &args,
+                    std::index_sequence<I...>, Items &...items) {
+  vecpar::detail::call_mapping_function(
+      algorithm, idx, items..., device_item(idx, std::get<I>(args))...);
+}
+
+/// the config is used on the host only: it sets the number of threads and
+/// the size of the scratch of every thread. Maps over several collections
+/// (Algorithm::input_count) read the items of all of them in the same loop;
+/// on the device the collections after the first one are copied with
+/// to_device and the other arguments are copied into the region.
 template <class Algorithm,
           typename R = typename Algorithm::intermediate_result_t, typename T,
           typename... Rest>
 requires detail::is_map<Algorithm, R, T, Rest...>
 R &parallel_map(Algorithm &algorithm,
-                __attribute__((unused)) vecmem::memory_resource &mr, T &data,
+                __attribute__((unused)) vecmem::memory_resource &mr,
+                __attribute__((unused)) vecpar::config config, T &data,
                 Rest &...rest) {
+  static_assert(!vecpar::collection::Any_soa_vector<R, T, Rest...>,
+                "soa_vector is supported by the OpenMP backend only");
+  static_assert(!vecpar::collection::Any_lazy_range<R, T, Rest...>,
+                "lazy ranges are supported by the OpenMP backend only");
+  static_assert(!vecpar::collection::Any_strided_view<R, T, Rest...>,
+                "strided views are supported by the OpenMP backend only, the "
+                "OpenMP target backend maps contiguous storage");
 
   int size = static_cast<int>(data.size());
   value_type_t<R> *map_result = new value_type_t<R>[size];
@@ -43,12 +121,14 @@ R &parallel_map(Algorithm &algorithm,
   DEBUG_ACTION(
       printf("[OMPT][map]Attempt to run on device with default config \n");)
   Algorithm *d_alg = (Algorithm *)omp_target_alloc(sizeof(Algorithm), 0);
+  auto d_rest = to_device<Algorithm::input_count - 1>(size, rest...);
+  constexpr auto rest_indices = std::index_sequence_for<Rest...>{};
   // if possible use shared memory
 
 #if _OPENMP >= 202111 and (__clang__ == 1 and __clang_major__ >= 16)
   const int grid_size = (size + BLOCK_SIZE - 1) / BLOCK_SIZE;
 #pragma omp target teams is_device_ptr(d_alg) map(to                           \
-                                                  : d_data [0:size])           \
+                                                  : d_data [0:size], d_rest)   \
     map(from                                                                   \
         : map_result [0:size]) num_teams(grid_size)
   {
@@ -68,10 +148,9 @@ R &parallel_map(Algorithm &algorithm,
         DEBUG_ACTION(printf("Current: team %d, thread %d; %f \n",
                             omp_get_team_num(), omp_get_thread_num(),
                             buffer[omp_get_thread_num()]);)
-        d_alg->mapping_function(
-            buffer[omp_get_thread_num()],
-            d_data[omp_get_team_num() * BLOCK_SIZE + omp_get_thread_num()],
-            rest...);
+        const int idx = omp_get_team_num() * BLOCK_SIZE + omp_get_thread_num();
+        call_on_device(*d_alg, idx, d_rest, rest_indices,
+                       buffer[omp_get_thread_num()], d_data[idx]);
       }
     }
 
@@ -86,17 +165,28 @@ R &parallel_map(Algorithm &algorithm,
 #else // no shared memory
 #pragma omp target teams distribute parallel for is_device_ptr(d_alg)          \
     map(to                                                                     \
-        : d_data [0:size]) map(from                                            \
-                               : map_result [0:size])
+        : d_data [0:size], d_rest) map(from                                    \
+                                       : map_result [0:size])
   for (int i = 0; i < size; i++) {
-    d_alg->mapping_function(map_result[i], d_data[i], rest...);
+    call_on_device(*d_alg, i, d_rest, rest_indices, map_result[i],
+                   d_data[i]);
   }
 #endif
+  free_device(d_rest);
 #else // defined(COMPILE_FOR_HOST)
   DEBUG_ACTION(printf("[OMPT][map]Running on host with default config \n");)
-#pragma omp parallel for
-  for (int i = 0; i < size; i++) {
-    algorithm.mapping_function(map_result[i], data[i], rest...);
+  const int threads = internal::get_num_threads(config);
+  const vecpar::detail::scratch_pool pool(config, threads);
+#pragma omp parallel num_threads(threads)
+  {
+    vecpar::detail::thread_scratch<Algorithm> s(algorithm, pool,
+                                                omp_get_thread_num());
+#pragma omp for
+    for (int i = 0; i < size; i++) {
+      vecpar::detail::call_mapping_function(algorithm, i, s.get(),
+                                            map_result[i], data[i],
+                                            get(i, rest)...);
+    }
   }
 #endif
   R *vecmem_result = new R(size, &mr);
@@ -104,14 +194,32 @@ R &parallel_map(Algorithm &algorithm,
   return *vecmem_result;
 }
 
-// mmap without user config
+template <class Algorithm,
+          typename R = typename Algorithm::intermediate_result_t, typename T,
+          typename... Rest>
+requires detail::is_map<Algorithm, R, T, Rest...>
+R &parallel_map(Algorithm &algorithm, vecmem::memory_resource &mr, T &data,
+                Rest &...rest) {
+  return vecpar::ompt::parallel_map(algorithm, mr, vecpar::config(), data,
+                                    rest...);
+}
+
+// mmap with user config (host only, as for map)
 template <class Algorithm,
           typename R = typename Algorithm::intermediate_result_t, typename T,
           typename... Rest>
 requires detail::is_mmap<Algorithm, T, Rest...>
-R &parallel_map(Algorithm &algorithm,
-                __attribute__((unused)) vecmem::memory_resource &mr, T &data,
+T &parallel_map(Algorithm &algorithm,
+                __attribute__((unused)) vecmem::memory_resource &mr,
+                __attribute__((unused)) vecpar::config config, T &data,
                 Rest &...rest) {
+  static_assert(!vecpar::collection::Any_soa_vector<R, T, Rest...>,
+                "soa_vector is supported by the OpenMP backend only");
+  static_assert(!vecpar::collection::Any_lazy_range<R, T, Rest...>,
+                "lazy ranges are supported by the OpenMP backend only");
+  static_assert(!vecpar::collection::Any_strided_view<R, T, Rest...>,
+                "strided views are supported by the OpenMP backend only, the "
+                "OpenMP target backend maps contiguous storage");
 
   int size = static_cast<int>(data.size());
   value_type_t<T> *d_data = data.data();
@@ -122,14 +230,16 @@ R &parallel_map(Algorithm &algorithm,
       printf("[OMPT][mmap]Attempt to run on device with default config \n");)
 
   Algorithm *d_alg = (Algorithm *)omp_target_alloc(sizeof(Algorithm), 0);
+  auto d_rest = to_device<Algorithm::input_count - 1>(size, rest...);
+  constexpr auto rest_indices = std::index_sequence_for<Rest...>{};
 
 #if _OPENMP >= 202111 and (__clang__ == 1 and __clang_major__ >= 16)
   // use shared memory
   const int grid_size = (size + BLOCK_SIZE - 1) / BLOCK_SIZE;
 #pragma omp target teams num_teams(grid_size) is_device_ptr(d_alg)             \
     map(tofrom                                                                 \
-        : d_data [0:size])
-  // map(to  : rest)
+        : d_data [0:size]) map(to                                              \
+                               : d_rest)
   {
     value_type_t<T> buffer[BLOCK_SIZE];
     // if the compiler supports OpenMP 5.2 allocators
@@ -145,7 +255,9 @@ R &parallel_map(Algorithm &algorithm,
     {
       // all threads use the shared memory for computing the output result
       if (omp_get_team_num() * BLOCK_SIZE + omp_get_thread_num() < size) {
-        d_alg->mapping_function(buffer[omp_get_thread_num()], rest...);
+        call_on_device(*d_alg,
+                       omp_get_team_num() * BLOCK_SIZE + omp_get_thread_num(),
+                       d_rest, rest_indices, buffer[omp_get_thread_num()]);
       }
     }
     // thread 0 from each block copies the results from shared memory to
@@ -159,30 +271,54 @@ R &parallel_map(Algorithm &algorithm,
 #else // no shared memory
 #pragma omp target teams distribute parallel for is_device_ptr(d_alg)          \
     map(tofrom                                                                 \
-        : d_data [0:size])
+        : d_data [0:size]) map(to                                              \
+                               : d_rest)
   for (int i = 0; i < size; i++) {
-    d_alg->mapping_function(d_data[i], rest...);
+    call_on_device(*d_alg, i, d_rest, rest_indices, d_data[i]);
   }
 #endif
+  free_device(d_rest);
 #else // defined(COMPILE_FOR_HOST)
   DEBUG_ACTION(printf("[OMPT][mmap]Running on host with default config \n");)
-#pragma omp parallel for
-  for (int i = 0; i < size; i++) {
-    algorithm.mapping_function(data[i], rest...);
+  const int threads = internal::get_num_threads(config);
+  const vecpar::detail::scratch_pool pool(config, threads);
+#pragma omp parallel num_threads(threads)
+  {
+    vecpar::detail::thread_scratch<Algorithm> s(algorithm, pool,
+                                                omp_get_thread_num());
+#pragma omp for
+    for (int i = 0; i < size; i++) {
+      vecpar::detail::call_mapping_function(algorithm, i, s.get(), data[i],
+                                            get(i, rest)...);
+    }
   }
 #endif
 
-  // update the input vector
-  data.assign(d_data, d_data + size);
+  // update the input vector (views share the storage of d_data)
+  if constexpr (!vecpar::collection::View_type<T>)
+    data.assign(d_data, d_data + size);
   return data;
 }
 
+// mmap without user config
+template <class Algorithm,
+          typename R = typename Algorithm::intermediate_result_t, typename T,
+          typename... Rest>
+requires detail::is_mmap<Algorithm, T, Rest...>
+T &parallel_map(Algorithm &algorithm, vecmem::memory_resource &mr, T &data,
+                Rest &...rest) {
+  return vecpar::ompt::parallel_map(algorithm, mr, vecpar::config(), data,
+                                    rest...);
+}
+
 // reduce without user config
 template <class Algorithm, typename R>
 requires detail::is_reduce<Algorithm, R>
 typename R::value_type &
 parallel_reduce(__attribute__((unused)) Algorithm &algorithm,
                 __attribute__((unused)) vecmem::memory_resource &mr, R &data) {
+  static_assert(!vecpar::collection::Any_soa_vector<R>,
+                "soa_vector is supported by the OpenMP backend only");
 
   using data_value_type = typename R::value_type;
   data_value_type *result = new data_value_type();
@@ -291,6 +427,8 @@ template <typename Algorithm, typename T>
 requires detail::is_filter<Algorithm, T>
 T &parallel_filter(__attribute__((unused)) Algorithm algorithm,
                    vecmem::memory_resource &mr, T &data) {
+  static_assert(!vecpar::collection::Any_soa_vector<T>,
+                "soa_vector is supported by the OpenMP backend only");
 
   T *result;
 
@@ -438,5 +576,32 @@ T &parallel_filter(__attribute__((unused)) Algorithm algorithm,
 
   return *result;
 }
+
+/// jagged collections are filtered and reduced on the host,
+/// by the OpenMP (CPU) backend
+template <typename Algorithm, typename T>
+requires detail::is_filter<Algorithm, T> &&
+    vecpar::collection::Jagged_vector_type<T> T &
+    parallel_filter(Algorithm algorithm, vecmem::memory_resource &mr,
+                    T &data) {
+  return vecpar::omp::parallel_filter(algorithm, mr, data);
+}
+
+template <class Algorithm, typename R>
+requires detail::is_reduce<Algorithm, R> &&
+    vecpar::collection::Jagged_vector_type<R>
+        vecpar::collection::value_type_t<R> &parallel_reduce(
+            Algorithm &algorithm, vecmem::memory_resource &mr, R &data) {
+  return vecpar::omp::parallel_reduce(algorithm, mr, data);
+}
+
+template <class Algorithm, typename R>
+requires detail::is_reduce<Algorithm, R> &&
+    vecpar::collection::Jagged_vector_type<R>
+        vecmem::vector<vecpar::collection::value_type_t<R>> &
+        parallel_reduce_rows(Algorithm &algorithm, vecmem::memory_resource &mr,
+                             R &data) {
+  return vecpar::omp::parallel_reduce_rows(algorithm, mr, data);
+}
 } // namespace vecpar::ompt
 #endif // VECPAR_OMPT_PARALLELIZATION_HPP
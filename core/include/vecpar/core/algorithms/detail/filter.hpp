@@ -6,8 +6,11 @@
 
 namespace vecpar::detail {
 
+/// for jagged collections the filter is applied to each element of the
+/// inner vectors (row-wise filtering)
 template <vecpar::collection::Iterable R> struct parallel_filter {
-  TARGET bool filtering_function(typename R::value_type &item) const;
+  TARGET bool
+  filtering_function(vecpar::collection::value_type_t<R> &item) const;
 };
 
 /// concepts
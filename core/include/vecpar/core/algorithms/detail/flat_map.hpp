@@ -0,0 +1,40 @@
+#ifndef VECPAR_FLAT_MAP_HPP
+#define VECPAR_FLAT_MAP_HPP
+
+#include <cstddef>
+#include <span>
+
+#include "vecpar/core/definitions/common.hpp"
+#include "vecpar/core/definitions/types.hpp"
+
+namespace vecpar::detail {
+
+/// map which produces a variable number (zero or more) of output items
+/// for every input item; the output items of all the inputs are stored
+/// contiguously, in the order of the inputs
+template <vecpar::collection::Iterable R, vecpar::collection::Iterable T,
+          typename... Arguments>
+struct parallel_flat_map {
+  /// number of output items produced for in_item
+  TARGET std::size_t count_function(const typename T::value_type &in_item,
+                                    Arguments &...obj) const;
+
+  /// fills out (sized as returned by count_function) for the idx-th input
+  TARGET void emit_function(std::size_t idx,
+                            std::span<typename R::value_type> out,
+                            const typename T::value_type &in_item,
+                            Arguments &...obj) const;
+  using input_t = T;
+  using input_ti = typename T::value_type;
+  using result_t = R;
+  using result_ti = typename R::value_type;
+};
+
+/// concepts
+template <typename Algorithm, typename... All>
+concept is_flat_map =
+    std::is_base_of<vecpar::detail::parallel_flat_map<All...>,
+                    Algorithm>::value;
+
+} // namespace vecpar::detail
+#endif // VECPAR_FLAT_MAP_HPP
@@ -1,7 +1,13 @@
 #ifndef VECPAR_MAP_HPP
 #define VECPAR_MAP_HPP
 
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
 #include "vecpar/core/definitions/common.hpp"
+#include "vecpar/core/definitions/reduced_precision.hpp"
+#include "vecpar/core/definitions/scratch.hpp"
 #include "vecpar/core/definitions/types.hpp"
 
 using namespace vecpar::collection;
@@ -19,6 +25,7 @@ struct parallel_map_one {
   using result_t = R;
   using result_ti = typename R::value_type;
   using intermediate_result_t = R;
+  static constexpr std::size_t input_count = 1;
 };
 
 /// 1 iterable and mutable collection
@@ -30,6 +37,7 @@ template <Iterable T, typename... Arguments> struct parallel_mmap_one {
   using result_t = T;
   using result_ti = typename T::value_type;
   using intermediate_result_t = T;
+  static constexpr std::size_t input_count = 1;
 };
 
 /// 2 iterable collections
@@ -42,6 +50,7 @@ struct parallel_map_two {
   using input_t = T1;
   using result_t = R;
   using intermediate_result_t = R;
+  static constexpr std::size_t input_count = 2;
 };
 
 /// 2 iterable collections; result in first collection
@@ -53,6 +62,7 @@ struct parallel_mmap_two {
   using input_t = T1;
   using result_t = T1;
   using intermediate_result_t = T1;
+  static constexpr std::size_t input_count = 2;
 };
 
 /// 3 iterable collections
@@ -67,6 +77,7 @@ struct parallel_map_three {
   using input_t = T1;
   using result_t = R;
   using intermediate_result_t = R;
+  static constexpr std::size_t input_count = 3;
 };
 
 /// 3 iterable collections; result in first collection
@@ -79,6 +90,7 @@ struct parallel_mmap_three {
   using input_t = T1;
   using result_t = T1;
   using intermediate_result_t = T1;
+  static constexpr std::size_t input_count = 3;
 };
 
 /// 4 iterable collections
@@ -94,6 +106,7 @@ struct parallel_map_four {
   using input_t = T1;
   using result_t = R;
   using intermediate_result_t = R;
+  static constexpr std::size_t input_count = 4;
 };
 
 /// 4 iterable collections; result in first collection
@@ -108,6 +121,7 @@ struct parallel_mmap_four {
   using input_t = T1;
   using result_t = T1;
   using intermediate_result_t = T1;
+  static constexpr std::size_t input_count = 4;
 };
 
 /// 5 iterable collections
@@ -124,6 +138,7 @@ struct parallel_map_five {
   using input_t = T1;
   using result_t = R;
   using intermediate_result_t = R;
+  static constexpr std::size_t input_count = 5;
 };
 
 /// 5 iterable collections; result in first collection
@@ -139,59 +154,206 @@ struct parallel_mmap_five {
   using input_t = T1;
   using result_t = T1;
   using intermediate_result_t = T1;
+  static constexpr std::size_t input_count = 5;
 };
 
-/// concepts
+/// number of iterable collections at the front of Arguments
+template <typename... Arguments>
+constexpr std::size_t leading_iterables = 0;
+
+template <typename First, typename... Rest>
+constexpr std::size_t leading_iterables<First, Rest...> =
+    Iterable<First> ? 1 + leading_iterables<Rest...> : 0;
+
+/// any number of iterable collections: the leading iterable arguments are
+/// read together item by item ("zipped"), the other arguments are passed
+/// unchanged, e.g. mapping_function(double &out_item, const float &in_1_item,
+/// ..., const float &in_8_item, double &obj)
+template <Iterable R, Iterable T, typename... Arguments>
+struct parallel_zip_map {
+  using input_t = T;
+  using result_t = R;
+  using intermediate_result_t = R;
+  static constexpr std::size_t input_count =
+      1 + leading_iterables<Arguments...>;
+};
+
+/// any number of iterable collections; result in first collection
+template <Iterable T, typename... Arguments> struct parallel_zip_mmap {
+  using input_t = T;
+  using result_t = T;
+  using intermediate_result_t = T;
+  static constexpr std::size_t input_count =
+      1 + leading_iterables<Arguments...>;
+};
+
+/// concepts; lazy ranges (see lazy.hpp) and views (see views.hpp) are
+/// accepted where the algorithm declares a vecmem::vector of the same
+/// elements, except that the collection updated by an mmap cannot be lazy
 
 template <typename Algorithm, typename... All>
 concept is_map_1 =
-    std::is_base_of<vecpar::detail::parallel_map_one<All...>, Algorithm>::value;
+    std::is_base_of<vecpar::detail::parallel_map_one<declared_t<All>...>,
+                    Algorithm>::value;
 
 template <typename Algorithm, typename... All>
 concept is_map_2 =
-    std::is_base_of<vecpar::detail::parallel_map_two<All...>, Algorithm>::value;
+    std::is_base_of<vecpar::detail::parallel_map_two<declared_t<All>...>,
+                    Algorithm>::value;
 
 template <typename Algorithm, typename... All>
-concept is_map_3 = std::is_base_of<vecpar::detail::parallel_map_three<All...>,
-                                   Algorithm>::value;
+concept is_map_3 =
+    std::is_base_of<vecpar::detail::parallel_map_three<declared_t<All>...>,
+                    Algorithm>::value;
 
 template <typename Algorithm, typename... All>
-concept is_map_4 = std::is_base_of<vecpar::detail::parallel_map_four<All...>,
-                                   Algorithm>::value;
+concept is_map_4 =
+    std::is_base_of<vecpar::detail::parallel_map_four<declared_t<All>...>,
+                    Algorithm>::value;
 
 template <typename Algorithm, typename... All>
-concept is_map_5 = std::is_base_of<vecpar::detail::parallel_map_five<All...>,
-                                   Algorithm>::value;
+concept is_map_5 =
+    std::is_base_of<vecpar::detail::parallel_map_five<declared_t<All>...>,
+                    Algorithm>::value;
+
+template <typename Algorithm, typename... All>
+concept is_zip_map =
+    std::is_base_of<vecpar::detail::parallel_zip_map<declared_t<All>...>,
+                    Algorithm>::value;
 
 template <typename Algorithm, typename... All>
 concept is_map = is_map_1<Algorithm, All...> || is_map_2<Algorithm, All...> ||
     is_map_3<Algorithm, All...> || is_map_4<Algorithm, All...> ||
-    is_map_5<Algorithm, All...>;
+    is_map_5<Algorithm, All...> || is_zip_map<Algorithm, All...>;
+
+template <typename Algorithm, typename... All>
+concept is_mmap_1 =
+    Updatable_first<All...> &&
+    std::is_base_of<vecpar::detail::parallel_mmap_one<declared_t<All>...>,
+                    Algorithm>::value;
 
 template <typename Algorithm, typename... All>
-concept is_mmap_1 = std::is_base_of<vecpar::detail::parallel_mmap_one<All...>,
-                                    Algorithm>::value;
+concept is_mmap_2 =
+    Updatable_first<All...> &&
+    std::is_base_of<vecpar::detail::parallel_mmap_two<declared_t<All>...>,
+                    Algorithm>::value;
 
 template <typename Algorithm, typename... All>
-concept is_mmap_2 = std::is_base_of<vecpar::detail::parallel_mmap_two<All...>,
-                                    Algorithm>::value;
+concept is_mmap_3 =
+    Updatable_first<All...> &&
+    std::is_base_of<vecpar::detail::parallel_mmap_three<declared_t<All>...>,
+                    Algorithm>::value;
 
 template <typename Algorithm, typename... All>
-concept is_mmap_3 = std::is_base_of<vecpar::detail::parallel_mmap_three<All...>,
-                                    Algorithm>::value;
+concept is_mmap_4 =
+    Updatable_first<All...> &&
+    std::is_base_of<vecpar::detail::parallel_mmap_four<declared_t<All>...>,
+                    Algorithm>::value;
 
 template <typename Algorithm, typename... All>
-concept is_mmap_4 = std::is_base_of<vecpar::detail::parallel_mmap_four<All...>,
-                                    Algorithm>::value;
+concept is_mmap_5 =
+    Updatable_first<All...> &&
+    std::is_base_of<vecpar::detail::parallel_mmap_five<declared_t<All>...>,
+                    Algorithm>::value;
 
 template <typename Algorithm, typename... All>
-concept is_mmap_5 = std::is_base_of<vecpar::detail::parallel_mmap_five<All...>,
-                                    Algorithm>::value;
+concept is_zip_mmap =
+    Updatable_first<All...> &&
+    std::is_base_of<vecpar::detail::parallel_zip_mmap<declared_t<All>...>,
+                    Algorithm>::value;
 
 template <typename Algorithm, typename... All>
 concept is_mmap = is_mmap_1<Algorithm, All...> ||
     is_mmap_2<Algorithm, All...> || is_mmap_3<Algorithm, All...> ||
-    is_mmap_4<Algorithm, All...> || is_mmap_5<Algorithm, All...>;
+    is_mmap_4<Algorithm, All...> || is_mmap_5<Algorithm, All...> ||
+    is_zip_mmap<Algorithm, All...>;
+
+/// the mapping function can also take the position of the item as first
+/// parameter, e.g. for position-dependent weights or per-item seeds
+template <typename Algorithm, typename... Items>
+concept has_indexed_mapping =
+    requires(Algorithm &algorithm, std::size_t idx, Items &&...items) {
+  algorithm.mapping_function(idx, std::forward<Items>(items)...);
+};
+
+template <typename Algorithm, typename... Items>
+concept has_mapping = requires(Algorithm &algorithm, Items &&...items) {
+  algorithm.mapping_function(std::forward<Items>(items)...);
+} || has_indexed_mapping<Algorithm, Items...>;
+
+/// an output item stored in a reduced-precision type (see
+/// reduced_precision.hpp) is widened to float for a mapping function which
+/// takes it as float & (the inputs convert implicitly)
+template <typename Algorithm, typename... Items>
+struct widened_mapping : std::false_type {};
+
+template <typename Algorithm, typename Out, typename... Items>
+struct widened_mapping<Algorithm, Out, Items...>
+    : std::bool_constant<
+          std::is_lvalue_reference_v<Out> &&
+          Reduced_precision_type<std::remove_cvref_t<Out>> &&
+          !has_mapping<Algorithm, Out, Items...> &&
+          has_mapping<Algorithm, compute_t<std::remove_cvref_t<Out>> &,
+                      Items...>> {};
+
+template <typename Algorithm, typename... Items>
+concept has_widened_mapping = widened_mapping<Algorithm, Items...>::value;
+
+/// loads the output item in the compute type, calls the mapping function
+/// and narrows the computed value back on store
+template <typename Algorithm, typename Out, typename... Items>
+TARGET void call_widened_mapping_function(Algorithm &algorithm,
+                                          std::size_t idx, Out &out,
+                                          Items &&...items) {
+  compute_t<Out> value = out;
+  if constexpr (has_indexed_mapping<Algorithm, compute_t<Out> &, Items...>)
+    algorithm.mapping_function(idx, value, std::forward<Items>(items)...);
+  else
+    algorithm.mapping_function(value, std::forward<Items>(items)...);
+  out = value;
+}
+
+/// calls the mapping function, with the position of the item if the
+/// algorithm accepts it
+template <typename Algorithm, typename... Items>
+TARGET decltype(auto) call_mapping_function(Algorithm &algorithm,
+                                            std::size_t idx,
+                                            Items &&...items) {
+  if constexpr (has_indexed_mapping<Algorithm, Items...>)
+    return algorithm.mapping_function(idx, std::forward<Items>(items)...);
+  else if constexpr (has_widened_mapping<Algorithm, Items...>)
+    return call_widened_mapping_function(algorithm, idx,
+                                         std::forward<Items>(items)...);
+  else
+    return algorithm.mapping_function(std::forward<Items>(items)...);
+}
+
+/// the mapping function can also take the scratch of the thread in front of
+/// the items (after the position, if any)
+template <typename Algorithm, typename... Items>
+concept has_scratch_mapping =
+    requires(Algorithm &algorithm, std::size_t idx, vecpar::scratch &s,
+             Items &&...items) {
+  algorithm.mapping_function(idx, s, std::forward<Items>(items)...);
+} || requires(Algorithm &algorithm, vecpar::scratch &s, Items &&...items) {
+  algorithm.mapping_function(s, std::forward<Items>(items)...);
+};
+
+/// calls the mapping function with the scratch of the thread if the
+/// algorithm accepts it, otherwise as above
+template <typename Algorithm, typename... Items>
+TARGET decltype(auto) call_mapping_function(Algorithm &algorithm,
+                                            std::size_t idx,
+                                            vecpar::scratch &s,
+                                            Items &&...items) {
+  if constexpr (has_indexed_mapping<Algorithm, vecpar::scratch &, Items...>)
+    return algorithm.mapping_function(idx, s, std::forward<Items>(items)...);
+  else if constexpr (has_scratch_mapping<Algorithm, Items...>)
+    return algorithm.mapping_function(s, std::forward<Items>(items)...);
+  else
+    return call_mapping_function(algorithm, idx,
+                                 std::forward<Items>(items)...);
+}
 
 } // namespace vecpar::detail
 #endif // VECPAR_MAP_HPP
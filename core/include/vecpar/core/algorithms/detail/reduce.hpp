@@ -2,17 +2,34 @@
 #define VECPAR_REDUCE_HPP
 
 #include "vecpar/core/definitions/common.hpp"
+#include "vecpar/core/definitions/types.hpp"
 
 namespace vecpar::detail {
 
 /**
  * The operation has to be commutative and associative
  * since the order is not guaranteed.
+ * For jagged collections the elements of the inner vectors are reduced.
  */
-template <Iterable R> struct parallel_reduce {
-  TARGET typename R::value_type *
-  reducing_function(typename R::value_type *result,
-                    typename R::value_type &partial_result) const;
+template <vecpar::collection::Iterable R> struct parallel_reduce {
+  TARGET vecpar::collection::value_type_t<R> *
+  reducing_function(vecpar::collection::value_type_t<R> *result,
+                    vecpar::collection::value_type_t<R> &partial_result) const;
+};
+
+/**
+ * Reduction of the elements of T into an accumulator of a different type
+ * (e.g. float inputs summed in double); follows the vecpar::reducers
+ * protocol. The operations have to be associative.
+ */
+template <vecpar::collection::Iterable T, typename Acc>
+struct parallel_transform_reduce {
+  TARGET Acc identity() const;
+  TARGET void accumulate(Acc &acc,
+                         const vecpar::collection::value_type_t<T> &item) const;
+  TARGET void combine(Acc &acc, const Acc &partial_result) const;
+  using input_t = T;
+  using result_t = Acc;
 };
 
 /// concepts
@@ -0,0 +1,48 @@
+#ifndef VECPAR_WINDOW_REDUCE_HPP
+#define VECPAR_WINDOW_REDUCE_HPP
+
+#include <cstddef>
+
+#include "vecpar/core/definitions/common.hpp"
+#include "vecpar/core/definitions/types.hpp"
+
+namespace vecpar::detail {
+
+/**
+ * Reduction over every window of W consecutive elements:
+ * the i-th item of the result is the reduction of data[i, i + W), so the
+ * result has data.size() - W + 1 items. The operation has to be associative.
+ * Optionally, the algorithm can also provide
+ *   inverse_function(value_type *result, value_type &item)
+ * which removes item from result (e.g. a subtraction for sums).
+ */
+template <std::size_t W, vecpar::collection::Iterable R>
+struct parallel_window_reduce {
+  static_assert(W > 0, "the window has to contain at least one element");
+  static constexpr std::size_t window_size = W;
+
+  TARGET vecpar::collection::value_type_t<R> *
+  reducing_function(vecpar::collection::value_type_t<R> *result,
+                    vecpar::collection::value_type_t<R> &partial_result) const;
+  using input_t = R;
+  using result_t = R;
+};
+
+/// concepts
+template <typename Algorithm, typename R>
+concept is_window_reduce = requires {
+  Algorithm::window_size;
+} && std::is_base_of<vecpar::detail::parallel_window_reduce<
+                         Algorithm::window_size, R>,
+                     Algorithm>::value;
+
+template <typename Algorithm, typename R>
+concept has_inverse_function =
+    requires(const Algorithm &algorithm,
+             vecpar::collection::value_type_t<R> *result,
+             vecpar::collection::value_type_t<R> &item) {
+  algorithm.inverse_function(result, item);
+};
+
+} // namespace vecpar::detail
+#endif // VECPAR_WINDOW_REDUCE_HPP
@@ -0,0 +1,19 @@
+#ifndef VECPAR_PARALLELIZABLE_FLAT_MAP_HPP
+#define VECPAR_PARALLELIZABLE_FLAT_MAP_HPP
+
+#include "vecpar/core/algorithms/detail/flat_map.hpp"
+
+namespace vecpar::algorithm {
+
+template <vecpar::collection::Iterable R, vecpar::collection::Iterable T,
+          typename... Arguments>
+struct parallelizable_flat_map
+    : public vecpar::detail::parallel_flat_map<R, T, Arguments...> {};
+
+/// concepts
+template <typename Algorithm, typename... All>
+concept is_flat_map =
+    std::is_base_of<parallelizable_flat_map<All...>, Algorithm>::value;
+
+} // namespace vecpar::algorithm
+#endif // VECPAR_PARALLELIZABLE_FLAT_MAP_HPP
@@ -49,22 +49,59 @@ template <typename... Arguments>
 struct parallelizable_mmap<Five, Arguments...>
     : public vecpar::detail::parallel_mmap_five<Arguments...> {};
 
+/// map over any number of iterable collections, deduced from the leading
+/// iterable types of Arguments, e.g. eight input columns and a weight:
+///   parallelizable_zip_map<vecmem::vector<double>, vecmem::vector<float>,
+///                          ..., vecmem::vector<float>, double>
+/// All the inputs are read in the same loop (one kernel on the GPU).
+template <typename R, typename... Arguments>
+struct parallelizable_zip_map
+    : public vecpar::detail::parallel_zip_map<R, Arguments...> {};
+
+/// zip map whose result is written into the first collection
+template <typename T, typename... Arguments>
+struct parallelizable_zip_mmap
+    : public vecpar::detail::parallel_zip_mmap<T, Arguments...> {};
+
+/// marker for maps over jagged collections whose mapping_function is written
+/// for one element of the inner vectors instead of a whole inner vector;
+/// the other jagged collections must have the same shape as the input, while
+/// the items of the (1D) vectors are passed to every element of their row
+struct elementwise {};
+
 /// concepts
 template <typename Algorithm, typename... All>
 concept is_map =
-    std::is_base_of<parallelizable_map<One, All...>, Algorithm>::value ||
-    std::is_base_of<parallelizable_map<Two, All...>, Algorithm>::value ||
-    std::is_base_of<parallelizable_map<Three, All...>, Algorithm>::value ||
-    std::is_base_of<parallelizable_map<Four, All...>, Algorithm>::value ||
-    std::is_base_of<parallelizable_map<Five, All...>, Algorithm>::value;
+    std::is_base_of<parallelizable_map<One, declared_t<All>...>,
+                    Algorithm>::value ||
+    std::is_base_of<parallelizable_map<Two, declared_t<All>...>,
+                    Algorithm>::value ||
+    std::is_base_of<parallelizable_map<Three, declared_t<All>...>,
+                    Algorithm>::value ||
+    std::is_base_of<parallelizable_map<Four, declared_t<All>...>,
+                    Algorithm>::value ||
+    std::is_base_of<parallelizable_map<Five, declared_t<All>...>,
+                    Algorithm>::value ||
+    std::is_base_of<parallelizable_zip_map<declared_t<All>...>,
+                    Algorithm>::value;
 
 template <typename Algorithm, typename... All>
-concept is_mmap =
-    std::is_base_of<parallelizable_mmap<One, All...>, Algorithm>::value ||
-    std::is_base_of<parallelizable_mmap<Two, All...>, Algorithm>::value ||
-    std::is_base_of<parallelizable_mmap<Three, All...>, Algorithm>::value ||
-    std::is_base_of<parallelizable_mmap<Four, All...>, Algorithm>::value ||
-    std::is_base_of<parallelizable_mmap<Five, All...>, Algorithm>::value;
+concept is_mmap = Updatable_first<All...> &&
+    (std::is_base_of<parallelizable_mmap<One, declared_t<All>...>,
+                     Algorithm>::value ||
+     std::is_base_of<parallelizable_mmap<Two, declared_t<All>...>,
+                     Algorithm>::value ||
+     std::is_base_of<parallelizable_mmap<Three, declared_t<All>...>,
+                     Algorithm>::value ||
+     std::is_base_of<parallelizable_mmap<Four, declared_t<All>...>,
+                     Algorithm>::value ||
+     std::is_base_of<parallelizable_mmap<Five, declared_t<All>...>,
+                     Algorithm>::value ||
+     std::is_base_of<parallelizable_zip_mmap<declared_t<All>...>,
+                     Algorithm>::value);
+
+template <typename Algorithm>
+concept is_elementwise = std::is_base_of<elementwise, Algorithm>::value;
 
 } // namespace vecpar::algorithm
 #endif // VECPAR_PARALLELIZABLE_MAP_HPP
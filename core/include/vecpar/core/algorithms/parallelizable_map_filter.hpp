@@ -79,23 +79,28 @@ struct parallelizable_mmap_filter<Five, R, Arguments...>
 
 template <typename Algorithm, typename... All>
 concept is_map_filter_1 =
-    std::is_base_of<parallelizable_map_filter<One, All...>, Algorithm>::value;
+    std::is_base_of<parallelizable_map_filter<One, declared_t<All>...>,
+                    Algorithm>::value;
 template <typename Algorithm, typename... All>
 
 concept is_map_filter_2 =
-    std::is_base_of<parallelizable_map_filter<Two, All...>, Algorithm>::value;
+    std::is_base_of<parallelizable_map_filter<Two, declared_t<All>...>,
+                    Algorithm>::value;
 
 template <typename Algorithm, typename... All>
 concept is_map_filter_3 =
-    std::is_base_of<parallelizable_map_filter<Three, All...>, Algorithm>::value;
+    std::is_base_of<parallelizable_map_filter<Three, declared_t<All>...>,
+                    Algorithm>::value;
 
 template <typename Algorithm, typename... All>
 concept is_map_filter_4 =
-    std::is_base_of<parallelizable_map_filter<Four, All...>, Algorithm>::value;
+    std::is_base_of<parallelizable_map_filter<Four, declared_t<All>...>,
+                    Algorithm>::value;
 
 template <typename Algorithm, typename... All>
 concept is_map_filter_5 =
-    std::is_base_of<parallelizable_map_filter<Five, All...>, Algorithm>::value;
+    std::is_base_of<parallelizable_map_filter<Five, declared_t<All>...>,
+                    Algorithm>::value;
 
 template <typename Algorithm, typename... All>
 concept is_map_filter = is_map_filter_1<Algorithm, All...> ||
@@ -104,24 +109,28 @@ concept is_map_filter = is_map_filter_1<Algorithm, All...> ||
 
 template <typename Algorithm, typename... All>
 concept is_mmap_filter_1 =
-    std::is_base_of<parallelizable_mmap_filter<One, All...>, Algorithm>::value;
+    std::is_base_of<parallelizable_mmap_filter<One, declared_t<All>...>,
+                    Algorithm>::value;
 template <typename Algorithm, typename... All>
 
 concept is_mmap_filter_2 =
-    std::is_base_of<parallelizable_mmap_filter<Two, All...>, Algorithm>::value;
+    std::is_base_of<parallelizable_mmap_filter<Two, declared_t<All>...>,
+                    Algorithm>::value;
 
 template <typename Algorithm, typename... All>
 concept is_mmap_filter_3 =
-    std::is_base_of<parallelizable_mmap_filter<Three, All...>,
+    std::is_base_of<parallelizable_mmap_filter<Three, declared_t<All>...>,
                     Algorithm>::value;
 
 template <typename Algorithm, typename... All>
 concept is_mmap_filter_4 =
-    std::is_base_of<parallelizable_mmap_filter<Four, All...>, Algorithm>::value;
+    std::is_base_of<parallelizable_mmap_filter<Four, declared_t<All>...>,
+                    Algorithm>::value;
 
 template <typename Algorithm, typename... All>
 concept is_mmap_filter_5 =
-    std::is_base_of<parallelizable_mmap_filter<Five, All...>, Algorithm>::value;
+    std::is_base_of<parallelizable_mmap_filter<Five, declared_t<All>...>,
+                    Algorithm>::value;
 
 template <typename Algorithm, typename... All>
 concept is_mmap_filter = is_mmap_filter_1<Algorithm, All...> ||
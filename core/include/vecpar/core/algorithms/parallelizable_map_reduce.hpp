@@ -102,23 +102,28 @@ struct parallelizable_mmap_reduce<Five, Result, R, Arguments...>
 /// concepts
 template <typename Algorithm, typename... All>
 concept is_map_reduce_1 =
-    std::is_base_of<parallelizable_map_reduce<One, All...>, Algorithm>::value;
+    std::is_base_of<parallelizable_map_reduce<One, declared_t<All>...>,
+                    Algorithm>::value;
 template <typename Algorithm, typename... All>
 
 concept is_map_reduce_2 =
-    std::is_base_of<parallelizable_map_reduce<Two, All...>, Algorithm>::value;
+    std::is_base_of<parallelizable_map_reduce<Two, declared_t<All>...>,
+                    Algorithm>::value;
 
 template <typename Algorithm, typename... All>
 concept is_map_reduce_3 =
-    std::is_base_of<parallelizable_map_reduce<Three, All...>, Algorithm>::value;
+    std::is_base_of<parallelizable_map_reduce<Three, declared_t<All>...>,
+                    Algorithm>::value;
 
 template <typename Algorithm, typename... All>
 concept is_map_reduce_4 =
-    std::is_base_of<parallelizable_map_reduce<Four, All...>, Algorithm>::value;
+    std::is_base_of<parallelizable_map_reduce<Four, declared_t<All>...>,
+                    Algorithm>::value;
 
 template <typename Algorithm, typename... All>
 concept is_map_reduce_5 =
-    std::is_base_of<parallelizable_map_reduce<Five, All...>, Algorithm>::value;
+    std::is_base_of<parallelizable_map_reduce<Five, declared_t<All>...>,
+                    Algorithm>::value;
 
 template <typename Algorithm, typename... All>
 concept is_map_reduce = is_map_reduce_1<Algorithm, All...> ||
@@ -127,24 +132,28 @@ concept is_map_reduce = is_map_reduce_1<Algorithm, All...> ||
 
 template <typename Algorithm, typename... All>
 concept is_mmap_reduce_1 =
-    std::is_base_of<parallelizable_mmap_reduce<One, All...>, Algorithm>::value;
+    std::is_base_of<parallelizable_mmap_reduce<One, declared_t<All>...>,
+                    Algorithm>::value;
 template <typename Algorithm, typename... All>
 
 concept is_mmap_reduce_2 =
-    std::is_base_of<parallelizable_mmap_reduce<Two, All...>, Algorithm>::value;
+    std::is_base_of<parallelizable_mmap_reduce<Two, declared_t<All>...>,
+                    Algorithm>::value;
 
 template <typename Algorithm, typename... All>
 concept is_mmap_reduce_3 =
-    std::is_base_of<parallelizable_mmap_reduce<Three, All...>,
+    std::is_base_of<parallelizable_mmap_reduce<Three, declared_t<All>...>,
                     Algorithm>::value;
 
 template <typename Algorithm, typename... All>
 concept is_mmap_reduce_4 =
-    std::is_base_of<parallelizable_mmap_reduce<Four, All...>, Algorithm>::value;
+    std::is_base_of<parallelizable_mmap_reduce<Four, declared_t<All>...>,
+                    Algorithm>::value;
 
 template <typename Algorithm, typename... All>
 concept is_mmap_reduce_5 =
-    std::is_base_of<parallelizable_mmap_reduce<Five, All...>, Algorithm>::value;
+    std::is_base_of<parallelizable_mmap_reduce<Five, declared_t<All>...>,
+                    Algorithm>::value;
 
 template <typename Algorithm, typename... All>
 concept is_mmap_reduce = is_mmap_reduce_1<Algorithm, All...> ||
@@ -8,6 +8,10 @@ namespace vecpar::algorithm {
 template <Iterable R>
 struct parallelizable_reduce : public vecpar::detail::parallel_reduce<R> {};
 
+template <vecpar::collection::Iterable T, typename Acc>
+struct parallelizable_transform_reduce
+    : public vecpar::detail::parallel_transform_reduce<T, Acc> {};
+
 /// concepts
 template <typename Algorithm, typename R>
 concept is_reduce = std::is_base_of<parallelizable_reduce<R>, Algorithm>::value;
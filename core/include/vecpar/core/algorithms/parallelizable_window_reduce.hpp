@@ -0,0 +1,20 @@
+#ifndef VECPAR_PARALLELIZABLE_WINDOW_REDUCE_HPP
+#define VECPAR_PARALLELIZABLE_WINDOW_REDUCE_HPP
+
+#include "vecpar/core/algorithms/detail/window_reduce.hpp"
+
+namespace vecpar::algorithm {
+
+template <std::size_t W, vecpar::collection::Iterable R>
+struct parallelizable_window_reduce
+    : public vecpar::detail::parallel_window_reduce<W, R> {};
+
+/// concepts
+template <typename Algorithm, typename R>
+concept is_window_reduce = requires {
+  Algorithm::window_size;
+} && std::is_base_of<parallelizable_window_reduce<Algorithm::window_size, R>,
+                     Algorithm>::value;
+
+} // namespace vecpar::algorithm
+#endif // VECPAR_PARALLELIZABLE_WINDOW_REDUCE_HPP
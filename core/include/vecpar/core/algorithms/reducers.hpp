@@ -0,0 +1,441 @@
+#ifndef VECPAR_REDUCERS_HPP
+#define VECPAR_REDUCERS_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "vecpar/core/definitions/common.hpp"
+#include "vecpar/core/definitions/reduced_precision.hpp"
+
+namespace vecpar::reducers {
+
+/**
+ * A reducer describes a reduction of elements of type T into an accumulator
+ * which does not have to be of type T:
+ *   identity<T>() or identity()     the neutral accumulator
+ *   accumulate(Acc &acc, const T &x) adds one element to an accumulator
+ *   combine(Acc &acc, const Acc &o)  merges a partial accumulator into acc
+ *   finalize(const Acc &acc)         (optional) the result of the reduction,
+ *                                    the accumulator itself by default
+ *   static lanes                     (optional) number of independent
+ *                                    accumulators per thread (SIMD lanes)
+ *   static op                        (optional) the equivalent native_op,
+ *                                    for the backends which can lower it
+ * The operations have to be associative. The backends accumulate contiguous
+ * chunks of the input and combine the partial accumulators in order.
+ * The built-in reducers accumulate reduced-precision elements (vecpar::half,
+ * vecpar::bfloat16) in float, except sum which accumulates them in double.
+ *
+ * Inside a reducers::tuple, algorithms with a (legacy)
+ * reducing_function(T *result, T &item) can be used as well.
+ */
+
+/// reductions which the backends can map to a native reduction
+/// (e.g. an OpenMP reduction clause)
+enum class native_op {
+  none,
+  plus,
+  multiplies,
+  min,
+  max,
+  bit_and,
+  bit_or,
+  bit_xor
+};
+
+namespace detail {
+
+template <typename Reducer, typename T>
+concept has_typed_identity = requires(const Reducer &r) {
+  r.template identity<T>();
+};
+
+template <typename Reducer>
+concept has_identity = requires(const Reducer &r) { r.identity(); };
+
+template <typename Reducer, typename Acc, typename T>
+concept has_accumulate = requires(const Reducer &r, Acc &acc, const T &x) {
+  r.accumulate(acc, x);
+};
+
+template <typename Reducer, typename Acc>
+concept has_combine = requires(const Reducer &r, Acc &acc, const Acc &o) {
+  r.combine(acc, o);
+};
+
+template <typename Reducer, typename Acc>
+concept has_finalize = requires(const Reducer &r, const Acc &acc) {
+  r.finalize(acc);
+};
+
+template <typename Reducer>
+concept has_lanes = requires { Reducer::lanes; };
+
+template <typename Reducer>
+concept has_native_op = requires { Reducer::op; };
+
+} // namespace detail
+
+/// neutral accumulator of the reducer for elements of type T; legacy
+/// reducing_function algorithms start from a value-initialized T
+template <typename T, typename Reducer> TARGET auto identity(const Reducer &r) {
+  if constexpr (detail::has_typed_identity<Reducer, T>)
+    return r.template identity<T>();
+  else if constexpr (detail::has_identity<Reducer>)
+    return r.identity();
+  else
+    return T();
+}
+
+template <typename Reducer, typename T>
+using accumulator_t = decltype(identity<T>(std::declval<const Reducer &>()));
+
+template <typename Reducer, typename Acc, typename T>
+TARGET void accumulate(const Reducer &r, Acc &acc, const T &x) {
+  if constexpr (detail::has_accumulate<Reducer, Acc, T>) {
+    r.accumulate(acc, x);
+  } else {
+    Acc item = x;
+    r.reducing_function(&acc, item);
+  }
+}
+
+template <typename Reducer, typename Acc>
+TARGET void combine(const Reducer &r, Acc &acc, const Acc &o) {
+  if constexpr (detail::has_combine<Reducer, Acc>) {
+    r.combine(acc, o);
+  } else {
+    Acc item = o;
+    r.reducing_function(&acc, item);
+  }
+}
+
+template <typename Reducer, typename Acc>
+TARGET auto finalize(const Reducer &r, const Acc &acc) {
+  if constexpr (detail::has_finalize<Reducer, Acc>)
+    return r.finalize(acc);
+  else
+    return acc;
+}
+
+/// type returned by a reduction of elements of type T
+template <typename Reducer, typename T>
+using result_t =
+    decltype(finalize(std::declval<const Reducer &>(),
+                      std::declval<const accumulator_t<Reducer, T> &>()));
+
+/// number of accumulators each thread should keep
+template <typename Reducer> constexpr std::size_t lanes() {
+  if constexpr (detail::has_lanes<Reducer>)
+    return Reducer::lanes;
+  else
+    return 1;
+}
+
+/// native operation equivalent to the reducer
+template <typename Reducer> constexpr native_op native() {
+  if constexpr (detail::has_native_op<Reducer>)
+    return Reducer::op;
+  else
+    return native_op::none;
+}
+
+/// concepts
+template <typename Reducer, typename T>
+concept is_reducer =
+    (detail::has_typed_identity<Reducer, T> || detail::has_identity<Reducer>)&&
+        detail::has_accumulate<Reducer, accumulator_t<Reducer, T>, T> &&
+    detail::has_combine<Reducer, accumulator_t<Reducer, T>>;
+
+/// accumulator of a sum of elements of type T: a float accumulator of
+/// reduced-precision elements loses the small items once it is 2^24 times
+/// larger than them, so these sums are accumulated in double
+template <typename T>
+using sum_t =
+    std::conditional_t<Reduced_precision_type<T>, double, compute_t<T>>;
+
+/// built-in reducers
+struct sum {
+  static constexpr native_op op = native_op::plus;
+
+  template <typename T> TARGET sum_t<T> identity() const { return sum_t<T>(); }
+  template <typename Acc, typename T>
+  TARGET void accumulate(Acc &acc, const T &x) const {
+    acc += x;
+  }
+  template <typename Acc> TARGET void combine(Acc &acc, const Acc &o) const {
+    acc += o;
+  }
+};
+
+struct min {
+  static constexpr native_op op = native_op::min;
+
+  template <typename T> TARGET compute_t<T> identity() const {
+    using Acc = compute_t<T>;
+    if constexpr (std::numeric_limits<Acc>::has_infinity)
+      return std::numeric_limits<Acc>::infinity();
+    else
+      return std::numeric_limits<Acc>::max();
+  }
+  template <typename Acc, typename T>
+  TARGET void accumulate(Acc &acc, const T &x) const {
+    if (x < acc)
+      acc = x;
+  }
+  template <typename Acc> TARGET void combine(Acc &acc, const Acc &o) const {
+    accumulate(acc, o);
+  }
+};
+
+struct max {
+  static constexpr native_op op = native_op::max;
+
+  template <typename T> TARGET compute_t<T> identity() const {
+    using Acc = compute_t<T>;
+    if constexpr (std::numeric_limits<Acc>::has_infinity)
+      return -std::numeric_limits<Acc>::infinity();
+    else
+      return std::numeric_limits<Acc>::lowest();
+  }
+  template <typename Acc, typename T>
+  TARGET void accumulate(Acc &acc, const T &x) const {
+    if (acc < x)
+      acc = x;
+  }
+  template <typename Acc> TARGET void combine(Acc &acc, const Acc &o) const {
+    accumulate(acc, o);
+  }
+};
+
+using plus = sum;
+
+struct multiplies {
+  static constexpr native_op op = native_op::multiplies;
+
+  template <typename T> TARGET compute_t<T> identity() const {
+    return compute_t<T>(1);
+  }
+  template <typename Acc, typename T>
+  TARGET void accumulate(Acc &acc, const T &x) const {
+    acc *= x;
+  }
+  template <typename Acc> TARGET void combine(Acc &acc, const Acc &o) const {
+    acc *= o;
+  }
+};
+
+struct bit_and {
+  static constexpr native_op op = native_op::bit_and;
+
+  template <typename T> TARGET T identity() const { return ~T(0); }
+  template <typename Acc, typename T>
+  TARGET void accumulate(Acc &acc, const T &x) const {
+    acc &= x;
+  }
+  template <typename Acc> TARGET void combine(Acc &acc, const Acc &o) const {
+    acc &= o;
+  }
+};
+
+struct bit_or {
+  static constexpr native_op op = native_op::bit_or;
+
+  template <typename T> TARGET T identity() const { return T(0); }
+  template <typename Acc, typename T>
+  TARGET void accumulate(Acc &acc, const T &x) const {
+    acc |= x;
+  }
+  template <typename Acc> TARGET void combine(Acc &acc, const Acc &o) const {
+    acc |= o;
+  }
+};
+
+struct bit_xor {
+  static constexpr native_op op = native_op::bit_xor;
+
+  template <typename T> TARGET T identity() const { return T(0); }
+  template <typename Acc, typename T>
+  TARGET void accumulate(Acc &acc, const T &x) const {
+    acc ^= x;
+  }
+  template <typename Acc> TARGET void combine(Acc &acc, const Acc &o) const {
+    acc ^= o;
+  }
+};
+
+/// number of reduced elements
+struct count {
+  template <typename T> TARGET std::size_t identity() const { return 0; }
+  template <typename T>
+  TARGET void accumulate(std::size_t &acc,
+                         __attribute__((unused)) const T &x) const {
+    acc++;
+  }
+  TARGET void combine(std::size_t &acc, const std::size_t &o) const {
+    acc += o;
+  }
+};
+
+/// compensated accumulator: the rounding error of the sum is kept in c
+template <typename T> struct compensated {
+  T sum = T();
+  T c = T();
+};
+
+/// compensated (Kahan-Babuska-Neumaier) summation: the rounding error of
+/// every addition is accumulated separately and added back at the end;
+/// the error terms of the per-thread (and per-lane) partials are combined.
+/// Must not be compiled with -ffast-math or similar, which would optimize
+/// the compensation away.
+struct kahan_sum {
+  static constexpr std::size_t lanes = 4;
+
+  template <typename T> TARGET compensated<T> identity() const { return {}; }
+
+  template <typename Acc, typename T>
+  TARGET void accumulate(Acc &acc, const T &x) const {
+    add(acc, x);
+  }
+
+  template <typename Acc> TARGET void combine(Acc &acc, const Acc &o) const {
+    add(acc, o.sum);
+    acc.c += o.c;
+  }
+
+  template <typename T>
+  TARGET T finalize(const compensated<T> &acc) const {
+    return acc.sum + acc.c;
+  }
+
+private:
+  template <typename T>
+  TARGET static void add(compensated<T> &acc, std::type_identity_t<T> x) {
+    const T t = acc.sum + x;
+    if (std::abs(acc.sum) >= std::abs(x))
+      acc.c += (acc.sum - t) + x;
+    else
+      acc.c += (x - t) + acc.sum;
+    acc.sum = t;
+  }
+};
+
+/// accumulator of the pairwise summation: blocks of elements are summed
+/// directly and the block sums are added along a binary tree, where
+/// levels[l] holds the sum of 2^l blocks
+template <typename T> struct pairwise_accumulator {
+  static constexpr std::size_t block_size = 128;
+
+  T block = T();
+  std::size_t in_block = 0;
+  std::uint64_t blocks = 0;
+  T levels[64] = {};
+
+  TARGET void push(T value) {
+    std::uint64_t n = blocks++;
+    int l = 0;
+    for (; n & 1; n >>= 1, l++) {
+      value = levels[l] + value;
+      levels[l] = T();
+    }
+    levels[l] = value;
+  }
+
+  TARGET T total() const {
+    T result = T();
+    for (int l = 0; l < 64; l++)
+      if ((blocks >> l) & 1)
+        result += levels[l];
+    return result + block;
+  }
+};
+
+/// pairwise summation: the error grows with the logarithm of the number of
+/// elements instead of linearly
+struct pairwise_sum {
+  template <typename T> TARGET pairwise_accumulator<T> identity() const {
+    return {};
+  }
+
+  template <typename Acc, typename T>
+  TARGET void accumulate(Acc &acc, const T &x) const {
+    acc.block += x;
+    if (++acc.in_block == Acc::block_size) {
+      acc.push(acc.block);
+      acc.block = 0;
+      acc.in_block = 0;
+    }
+  }
+
+  template <typename Acc> TARGET void combine(Acc &acc, const Acc &o) const {
+    acc.push(o.total());
+  }
+
+  template <typename T>
+  TARGET T finalize(const pairwise_accumulator<T> &acc) const {
+    return acc.total();
+  }
+};
+
+/// several independent reductions in a single pass over the input;
+/// the accumulator is the std::tuple of the accumulators of the reducers
+template <typename... Reducers> struct tuple {
+  TARGET tuple() = default;
+  TARGET tuple(Reducers... r) : reducers(r...) {}
+
+  template <typename T>
+  TARGET std::tuple<accumulator_t<Reducers, T>...> identity() const {
+    return identity<T>(std::index_sequence_for<Reducers...>{});
+  }
+
+  template <typename Acc, typename T>
+  TARGET void accumulate(Acc &acc, const T &x) const {
+    accumulate(acc, x, std::index_sequence_for<Reducers...>{});
+  }
+
+  template <typename Acc> TARGET void combine(Acc &acc, const Acc &o) const {
+    combine(acc, o, std::index_sequence_for<Reducers...>{});
+  }
+
+  template <typename Acc> TARGET auto finalize(const Acc &acc) const {
+    return finalize(acc, std::index_sequence_for<Reducers...>{});
+  }
+
+  std::tuple<Reducers...> reducers;
+
+private:
+  template <typename T, std::size_t... I>
+  TARGET std::tuple<accumulator_t<Reducers, T>...>
+  identity(std::index_sequence<I...>) const {
+    return {vecpar::reducers::identity<T>(std::get<I>(reducers))...};
+  }
+
+  template <typename Acc, typename T, std::size_t... I>
+  TARGET void accumulate(Acc &acc, const T &x,
+                         std::index_sequence<I...>) const {
+    (vecpar::reducers::accumulate(std::get<I>(reducers), std::get<I>(acc), x),
+     ...);
+  }
+
+  template <typename Acc, std::size_t... I>
+  TARGET void combine(Acc &acc, const Acc &o,
+                      std::index_sequence<I...>) const {
+    (vecpar::reducers::combine(std::get<I>(reducers), std::get<I>(acc),
+                               std::get<I>(o)),
+     ...);
+  }
+
+  template <typename Acc, std::size_t... I>
+  TARGET auto finalize(const Acc &acc, std::index_sequence<I...>) const {
+    return std::make_tuple(
+        vecpar::reducers::finalize(std::get<I>(reducers), std::get<I>(acc))...);
+  }
+};
+
+} // namespace vecpar::reducers
+#endif // VECPAR_REDUCERS_HPP
@@ -0,0 +1,136 @@
+#ifndef VECPAR_ALIGNED_MEMORY_RESOURCE_HPP
+#define VECPAR_ALIGNED_MEMORY_RESOURCE_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+
+#include <vecmem/memory/memory_resource.hpp>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace vecpar {
+
+/// host memory resource with aligned allocations (64 bytes, i.e. a cache
+/// line and an AVX-512 register, by default). Allocations from
+/// huge_page_size bytes on are made with mmap, aligned to a huge page and
+/// backed by huge pages, which reduces the TLB misses of large
+/// collections:
+///   transparent   the kernel is asked (madvise) to use transparent huge
+///                 pages; without them the memory uses regular pages
+///   explicit_pool pages from the hugetlbfs pool (MAP_HUGETLB), with the
+///                 transparent ones as fallback when the pool is empty
+/// On systems without mmap all the allocations use aligned_alloc. The
+/// alignment must be a power of two, otherwise the constructor throws
+/// std::invalid_argument.
+class aligned_memory_resource : public vecmem::memory_resource {
+public:
+  enum class huge_pages { none, transparent, explicit_pool };
+
+  static constexpr std::size_t default_alignment = 64;
+  static constexpr std::size_t huge_page_size = std::size_t(2) << 20;
+
+  explicit aligned_memory_resource(
+      std::size_t alignment = default_alignment,
+      huge_pages pages = huge_pages::transparent)
+      : m_alignment(std::max(alignment, alignof(std::max_align_t))),
+        m_pages(pages) {
+    if (!std::has_single_bit(alignment))
+      throw std::invalid_argument("the alignment is not a power of two");
+  }
+
+  std::size_t alignment() const { return m_alignment; }
+
+  /// whether p is aligned as the allocations of this resource
+  bool is_aligned(const void *p) const {
+    return reinterpret_cast<std::uintptr_t>(p) % m_alignment == 0;
+  }
+
+private:
+  static std::size_t round_up(std::size_t bytes, std::size_t to) {
+    return (bytes + to - 1) / to * to;
+  }
+
+  bool uses_huge_pages(std::size_t bytes, std::size_t alignment) const {
+#if defined(__linux__)
+    return m_pages != huge_pages::none && bytes >= huge_page_size &&
+           alignment <= huge_page_size;
+#else
+    (void)bytes;
+    (void)alignment;
+    return false;
+#endif
+  }
+
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+    alignment = std::max(alignment, m_alignment);
+    if (!uses_huge_pages(bytes, alignment)) {
+      void *p = std::aligned_alloc(alignment,
+                                   round_up(std::max<std::size_t>(bytes, 1),
+                                            alignment));
+      if (p == nullptr)
+        throw std::bad_alloc();
+      return p;
+    }
+#if defined(__linux__)
+    const std::size_t size = round_up(bytes, huge_page_size);
+    if (m_pages == huge_pages::explicit_pool) {
+      int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB;
+#if defined(MAP_HUGE_2MB)
+      flags |= MAP_HUGE_2MB;
+#endif
+      void *p = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+      if (p != MAP_FAILED)
+        return p;
+    }
+    // over-allocate by one huge page and trim, so that the mapping starts
+    // at a huge page boundary
+    void *mapping = mmap(nullptr, size + huge_page_size, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED)
+      throw std::bad_alloc();
+    char *begin = static_cast<char *>(mapping);
+    char *p = reinterpret_cast<char *>(
+        round_up(reinterpret_cast<std::uintptr_t>(begin), huge_page_size));
+    if (p != begin)
+      munmap(begin, p - begin);
+    if (p + size != begin + size + huge_page_size)
+      munmap(p + size, begin + size + huge_page_size - (p + size));
+#if defined(MADV_HUGEPAGE)
+    // fails harmlessly when transparent huge pages are disabled
+    madvise(p, size, MADV_HUGEPAGE);
+#endif
+    return p;
+#else
+    return nullptr;
+#endif
+  }
+
+  void do_deallocate(void *p, std::size_t bytes,
+                     std::size_t alignment) override {
+    alignment = std::max(alignment, m_alignment);
+    if (!uses_huge_pages(bytes, alignment)) {
+      std::free(p);
+      return;
+    }
+#if defined(__linux__)
+    munmap(p, round_up(bytes, huge_page_size));
+#endif
+  }
+
+  bool do_is_equal(const vecmem::memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+
+  std::size_t m_alignment;
+  huge_pages m_pages;
+};
+
+} // namespace vecpar
+#endif // VECPAR_ALIGNED_MEMORY_RESOURCE_HPP
@@ -4,6 +4,14 @@
 
 namespace vecpar {
 
+/// how the CPU backends write the results of a map: streaming
+/// (non-temporal) stores bypass the caches, which can pay off for large
+/// outputs that are not read again soon. Regular stores are the default,
+/// since the copy through the per-thread buffer was measured slower than
+/// regular stores in most runs; automatic streams the outputs larger than
+/// the last-level cache.
+enum class store_hint { automatic, regular, streaming };
+
 class config {
 
 public:
@@ -21,6 +29,7 @@ public:
   int m_gridSize = 0;
   int m_blockSize = 0;
   size_t m_memorySize = 0;
+  store_hint m_storeHint = store_hint::regular;
 };
 } // namespace vecpar
 
@@ -0,0 +1,53 @@
+#ifndef VECPAR_CSR_HPP
+#define VECPAR_CSR_HPP
+
+#include <cstddef>
+#include <span>
+
+#include <vecmem/containers/data/jagged_vector_view.hpp>
+#include <vecmem/containers/data/vector_view.hpp>
+#include <vecmem/containers/vector.hpp>
+#include <vecmem/memory/memory_resource.hpp>
+
+namespace vecpar::collection {
+
+/// jagged collection in compressed-sparse-row form: the inner vectors are
+/// stored back to back in one buffer, row i being
+/// values[offsets[i], offsets[i + 1]). rows holds one view per inner vector
+/// (pointing into values) so that the collection can be consumed as a
+/// vecmem::data::jagged_vector_view; the shape is fixed once filled.
+template <typename T> struct csr_vector {
+  using value_type = T;
+
+  csr_vector(vecmem::memory_resource &mr)
+      : values(&mr), offsets(&mr), rows(&mr) {}
+
+  /// a copy would keep viewing the rows of the original
+  csr_vector(const csr_vector &) = delete;
+  csr_vector &operator=(const csr_vector &) = delete;
+  csr_vector(csr_vector &&) = default;
+  csr_vector &operator=(csr_vector &&) = default;
+
+  /// number of inner vectors
+  std::size_t size() const { return rows.size(); }
+
+  std::span<T> operator[](std::size_t row) {
+    return {values.data() + offsets[row], offsets[row + 1] - offsets[row]};
+  }
+
+  vecmem::data::jagged_vector_view<T> get_data() {
+    return {rows.size(), rows.data()};
+  }
+
+  vecmem::vector<T> values;
+  vecmem::vector<std::size_t> offsets;
+  vecmem::vector<vecmem::data::vector_view<T>> rows;
+};
+
+template <typename T>
+vecmem::data::jagged_vector_view<T> get_data(csr_vector<T> &csr) {
+  return csr.get_data();
+}
+
+} // namespace vecpar::collection
+#endif // VECPAR_CSR_HPP
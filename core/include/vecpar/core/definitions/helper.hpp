@@ -1,6 +1,8 @@
 #ifndef VECPAR_HELPER_HPP
 #define VECPAR_HELPER_HPP
 
+#include <cstddef>
+
 #include "vecpar/core/definitions/types.hpp"
 
 template <Iterable i>
@@ -13,4 +15,60 @@ static inline auto get(__attribute__((unused)) int idx, Object &o) -> Object & {
   return o;
 }
 
+/// lazy ranges compute the element, which is returned by value
+template <Lazy_range_type i>
+static inline auto get(int idx, i &collection) -> typename i::value_type {
+  return collection[idx];
+}
+
+template <View_type i>
+static inline auto get(int idx, i &collection) -> decltype(collection[idx]) {
+  return collection[idx];
+}
+
+/// soa collections return a proxy to the fields of the element
+template <Soa_vector_type i>
+static inline auto get(int idx, i &collection) -> typename i::value_type {
+  return collection[idx];
+}
+
+/// element access for elementwise maps over jagged collections
+template <Jagged_vector_type i>
+static inline auto get(std::size_t row, std::size_t col, i &collection)
+    -> value_type_t<i> & {
+  return collection[row][col];
+}
+
+template <Vector_type i>
+requires(!Jagged_vector_type<i>) static inline auto get(
+    std::size_t row, __attribute__((unused)) std::size_t col, i &collection)
+    -> typename i::value_type & {
+  return collection[row];
+}
+
+template <Lazy_range_type i>
+static inline auto get(std::size_t row, __attribute__((unused)) std::size_t col,
+                       i &collection) -> typename i::value_type {
+  return collection[row];
+}
+
+template <View_type i>
+static inline auto get(std::size_t row, __attribute__((unused)) std::size_t col,
+                       i &collection) -> decltype(collection[row]) {
+  return collection[row];
+}
+
+template <Soa_vector_type i>
+static inline auto get(std::size_t row, __attribute__((unused)) std::size_t col,
+                       i &collection) -> typename i::value_type {
+  return collection[row];
+}
+
+template <typename Object>
+static inline auto get(__attribute__((unused)) std::size_t row,
+                       __attribute__((unused)) std::size_t col, Object &o)
+    -> Object & {
+  return o;
+}
+
 #endif // VECPAR_HELPER_HPP
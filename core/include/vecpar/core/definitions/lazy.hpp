@@ -0,0 +1,90 @@
+#ifndef VECPAR_LAZY_HPP
+#define VECPAR_LAZY_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "vecpar/core/definitions/common.hpp"
+#include "vecpar/core/definitions/types.hpp"
+
+namespace vecpar::collection {
+
+/// first, first + 1, ..., first + size - 1
+template <typename T> struct counting_range {
+  using value_type = T;
+  using lazy_range = void;
+
+  T first;
+  std::size_t count;
+
+  TARGET std::size_t size() const { return count; }
+  TARGET T operator[](std::size_t i) const {
+    return first + static_cast<T>(i);
+  }
+};
+
+/// size copies of the same value
+template <typename T> struct constant_range {
+  using value_type = T;
+  using lazy_range = void;
+
+  T value;
+  std::size_t count;
+
+  TARGET std::size_t size() const { return count; }
+  TARGET T operator[](__attribute__((unused)) std::size_t i) const {
+    return value;
+  }
+};
+
+/// f applied to every element of a collection (kept by reference) or of
+/// another lazy range (kept by value)
+template <typename Collection, typename Function> struct transformed_range {
+  using value_type = std::remove_cvref_t<std::invoke_result_t<
+      const Function &, decltype(std::declval<Collection &>()[0])>>;
+  using lazy_range = void;
+
+  std::conditional_t<Lazy_range_type<Collection>,
+                     std::remove_cv_t<Collection>, Collection &>
+      collection;
+  Function f;
+
+  TARGET std::size_t size() const { return collection.size(); }
+  TARGET value_type operator[](std::size_t i) const { return f(collection[i]); }
+};
+
+} // namespace vecpar::collection
+
+namespace vecpar {
+
+/// lazy inputs: the elements are computed when the backend reads them.
+/// The OpenMP backend takes its inputs by forwarding reference, so they can
+/// be created in the call itself.
+template <typename T>
+collection::counting_range<T> counting(T first, std::size_t size) {
+  return {first, size};
+}
+
+template <typename T> collection::counting_range<T> counting(T size) {
+  return {T(0), static_cast<std::size_t>(size)};
+}
+
+template <typename T>
+collection::constant_range<T> constant(T value, std::size_t size) {
+  return {value, size};
+}
+
+/// a collection is kept by reference, a lazy range (which may be a
+/// temporary) by value
+template <typename Collection, typename Function>
+requires std::is_lvalue_reference_v<Collection> ||
+    collection::Lazy_range_type<std::remove_cvref_t<Collection>>
+collection::transformed_range<std::remove_reference_t<Collection>,
+                              std::decay_t<Function>>
+transformed(Collection &&collection, Function &&f) {
+  return {std::forward<Collection>(collection), std::forward<Function>(f)};
+}
+
+} // namespace vecpar
+#endif // VECPAR_LAZY_HPP
@@ -0,0 +1,187 @@
+#ifndef VECPAR_REDUCED_PRECISION_HPP
+#define VECPAR_REDUCED_PRECISION_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__F16C__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+#include "vecpar/core/definitions/common.hpp"
+
+namespace vecpar {
+
+/// 16-bit storage types: collections of them take half of the memory (and
+/// bandwidth) of float collections, while the computations are done in
+/// float. The values convert implicitly from and to float, so a
+/// mapping_function can also be written for the storage type directly.
+
+/// IEEE 754 binary16 (5 exponent bits, 10 mantissa bits). When the compiler
+/// provides _Float16, the conversions are left to it (F16C or AVX512-FP16
+/// instructions, depending on the target flags); otherwise they are done
+/// in software, rounding to nearest even.
+class half {
+public:
+  half() = default;
+  TARGET half(float value) : m_value(from_float(value)) {}
+
+  TARGET operator float() const { return to_float(m_value); }
+
+  TARGET half &operator+=(float x) { return *this = float(*this) + x; }
+  TARGET half &operator-=(float x) { return *this = float(*this) - x; }
+  TARGET half &operator*=(float x) { return *this = float(*this) * x; }
+  TARGET half &operator/=(float x) { return *this = float(*this) / x; }
+
+private:
+#if defined(__FLT16_MANT_DIG__)
+  using storage_t = _Float16;
+
+  TARGET static storage_t from_float(float value) {
+    return static_cast<_Float16>(value);
+  }
+  TARGET static float to_float(storage_t value) {
+    return static_cast<float>(value);
+  }
+#else
+  using storage_t = std::uint16_t;
+
+  TARGET static storage_t from_float(float value) {
+    const std::uint32_t x = std::bit_cast<std::uint32_t>(value);
+    const std::uint32_t sign = (x >> 16) & 0x8000u;
+    const std::uint32_t abs = x & 0x7fffffffu;
+
+    if (abs >= 0x7f800000u) // infinity and NaN (kept quiet)
+      return sign | 0x7c00u | (abs > 0x7f800000u ? 0x0200u : 0u);
+    if (abs >= 0x477ff000u) // rounds above the largest half (65504)
+      return sign | 0x7c00u;
+    if (abs < 0x38800000u) { // below the smallest normal half (2^-14)
+      if (abs < 0x33000000u) // below half of the smallest subnormal
+        return sign;
+      const std::uint32_t mantissa = (abs & 0x007fffffu) | 0x00800000u;
+      const std::uint32_t shift = 126u - (abs >> 23);
+      const std::uint32_t rest = mantissa & ((1u << shift) - 1u);
+      const std::uint32_t halfway = 1u << (shift - 1u);
+      std::uint32_t result = mantissa >> shift;
+      if (rest > halfway || (rest == halfway && (result & 1u)))
+        result++;
+      return sign | result;
+    }
+    // normal: rebias the exponent (127 -> 15) and round the mantissa
+    std::uint32_t result = abs - 0x38000000u;
+    result += 0x0fffu + ((result >> 13) & 1u);
+    return sign | (result >> 13);
+  }
+
+  TARGET static float to_float(storage_t value) {
+    const std::uint32_t sign = std::uint32_t(value & 0x8000u) << 16;
+    const std::uint32_t exponent = (value >> 10) & 0x1fu;
+    const std::uint32_t mantissa = value & 0x03ffu;
+
+    if (exponent == 0x1fu)
+      return std::bit_cast<float>(sign | 0x7f800000u | (mantissa << 13));
+    if (exponent == 0) { // zero and subnormals: mantissa * 2^-24
+      const float result = mantissa * 5.9604644775390625e-8f;
+      return sign ? -result : result;
+    }
+    return std::bit_cast<float>(sign | ((exponent + 112u) << 23) |
+                                (mantissa << 13));
+  }
+#endif
+
+  storage_t m_value;
+};
+
+/// bfloat16: the upper half of a float (8 exponent bits, 7 mantissa bits),
+/// i.e. the range of float with less precision. Widening is a shift and
+/// narrowing rounds to nearest even; both vectorize without special
+/// instructions.
+class bfloat16 {
+public:
+  bfloat16() = default;
+  TARGET bfloat16(float value) : m_bits(from_float(value)) {}
+
+  TARGET operator float() const {
+    return std::bit_cast<float>(std::uint32_t(m_bits) << 16);
+  }
+
+  TARGET bfloat16 &operator+=(float x) { return *this = float(*this) + x; }
+  TARGET bfloat16 &operator-=(float x) { return *this = float(*this) - x; }
+  TARGET bfloat16 &operator*=(float x) { return *this = float(*this) * x; }
+  TARGET bfloat16 &operator/=(float x) { return *this = float(*this) / x; }
+
+private:
+  TARGET static std::uint16_t from_float(float value) {
+    std::uint32_t x = std::bit_cast<std::uint32_t>(value);
+    if ((x & 0x7fffffffu) > 0x7f800000u) // NaN (kept quiet)
+      return (x >> 16) | 0x0040u;
+    x += 0x7fffu + ((x >> 16) & 1u);
+    return x >> 16;
+  }
+
+  std::uint16_t m_bits;
+};
+
+static_assert(sizeof(half) == 2 && sizeof(bfloat16) == 2);
+
+/// the type in which the elements of a collection of T are computed
+template <typename T> struct compute_type { using type = T; };
+template <> struct compute_type<half> { using type = float; };
+template <> struct compute_type<bfloat16> { using type = float; };
+
+template <typename T> using compute_t = typename compute_type<T>::type;
+
+template <typename T>
+concept Reduced_precision_type = !std::is_same_v<compute_t<T>, T>;
+
+/// converts n consecutive values to float; for half, 16 (AVX-512) or 8
+/// (F16C) values are converted per instruction when the target has them
+inline void widen(const half *in, float *out, std::size_t n) {
+  std::size_t i = 0;
+#if defined(__AVX512F__)
+  for (; i + 16 <= n; i += 16)
+    _mm512_storeu_ps(out + i, _mm512_cvtph_ps(_mm256_loadu_si256(
+                                  reinterpret_cast<const __m256i *>(in + i))));
+#endif
+#if defined(__F16C__)
+  for (; i + 8 <= n; i += 8)
+    _mm256_storeu_ps(out + i, _mm256_cvtph_ps(_mm_loadu_si128(
+                                  reinterpret_cast<const __m128i *>(in + i))));
+#endif
+  for (; i < n; i++)
+    out[i] = in[i];
+}
+
+/// converts n consecutive floats to half, rounding to nearest even
+inline void narrow(const float *in, half *out, std::size_t n) {
+  std::size_t i = 0;
+#if defined(__AVX512F__)
+  for (; i + 16 <= n; i += 16)
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i),
+                        _mm512_cvtps_ph(_mm512_loadu_ps(in + i),
+                                        _MM_FROUND_TO_NEAREST_INT));
+#endif
+#if defined(__F16C__)
+  for (; i + 8 <= n; i += 8)
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i),
+                     _mm256_cvtps_ph(_mm256_loadu_ps(in + i),
+                                     _MM_FROUND_TO_NEAREST_INT));
+#endif
+  for (; i < n; i++)
+    out[i] = in[i];
+}
+
+inline void widen(const bfloat16 *in, float *out, std::size_t n) {
+  for (std::size_t i = 0; i < n; i++)
+    out[i] = in[i];
+}
+
+inline void narrow(const float *in, bfloat16 *out, std::size_t n) {
+  for (std::size_t i = 0; i < n; i++)
+    out[i] = in[i];
+}
+
+} // namespace vecpar
+#endif // VECPAR_REDUCED_PRECISION_HPP
@@ -0,0 +1,121 @@
+#ifndef VECPAR_SCRATCH_HPP
+#define VECPAR_SCRATCH_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+#include "vecpar/core/definitions/common.hpp"
+#include "vecpar/core/definitions/config.hpp"
+
+namespace vecpar {
+
+/// temporary memory owned by one thread for a whole parallel region
+/// (config::m_memorySize bytes on the CPU backends). Algorithms receive it
+/// by declaring a vecpar::scratch & parameter in front of the items of
+/// mapping_function (after the position, if any); the content is kept
+/// between the items processed by the same thread.
+struct scratch {
+  void *data = nullptr;
+  std::size_t size = 0;
+  /// number of the owning thread within the parallel region
+  int thread = 0;
+
+  template <typename T> TARGET T *as() const { return static_cast<T *>(data); }
+};
+
+namespace detail {
+
+/// alignment of the scratch of every thread; a multiple of the cache line,
+/// so the buffers of different threads never share a line
+constexpr std::size_t scratch_alignment = 64;
+
+/// per-thread state set up by the algorithm, e.g. a random number generator
+/// constructed into the scratch
+template <typename Algorithm>
+concept has_thread_init = requires(Algorithm &algorithm, scratch &s) {
+  algorithm.thread_init(s);
+};
+
+template <typename Algorithm>
+concept has_thread_finalize = requires(Algorithm &algorithm, scratch &s) {
+  algorithm.thread_finalize(s);
+};
+
+/// the scratch of all the threads of a parallel region, allocated as one
+/// block before the region starts: an exception must not leave an OpenMP
+/// parallel region, so a failed allocation throws std::bad_alloc here, on
+/// the calling thread
+class scratch_pool {
+public:
+  scratch_pool(vecpar::config config, int threads)
+      : m_size(config.m_memorySize),
+        m_stride((config.m_memorySize + scratch_alignment - 1) /
+                 scratch_alignment * scratch_alignment),
+        m_threads(threads) {
+    if (m_size > 0) {
+      if (m_stride > std::numeric_limits<std::size_t>::max() /
+                         static_cast<std::size_t>(threads))
+        throw std::bad_alloc();
+      m_data = std::aligned_alloc(scratch_alignment,
+                                  m_stride * static_cast<std::size_t>(threads));
+      if (m_data == nullptr)
+        throw std::bad_alloc();
+    }
+  }
+
+  ~scratch_pool() { std::free(m_data); }
+
+  scratch_pool(const scratch_pool &) = delete;
+  scratch_pool &operator=(const scratch_pool &) = delete;
+
+  /// the scratch of the given thread, which is lower than the number of
+  /// threads of the pool
+  scratch get(int thread) const {
+    scratch s;
+    s.thread = thread;
+    if (m_data != nullptr && thread < m_threads) {
+      s.data = static_cast<char *>(m_data) +
+               static_cast<std::size_t>(thread) * m_stride;
+      s.size = m_size;
+    }
+    return s;
+  }
+
+private:
+  void *m_data = nullptr;
+  std::size_t m_size;
+  std::size_t m_stride;
+  int m_threads;
+};
+
+/// the scratch of one thread, taken from the pool of its parallel region,
+/// with the algorithm hooks run around its lifetime; the hooks of different
+/// threads run concurrently
+template <typename Algorithm> class thread_scratch {
+public:
+  thread_scratch(Algorithm &algorithm, const scratch_pool &pool, int thread)
+      : m_algorithm(algorithm), m_scratch(pool.get(thread)) {
+    if constexpr (has_thread_init<Algorithm>)
+      m_algorithm.thread_init(m_scratch);
+  }
+
+  ~thread_scratch() {
+    if constexpr (has_thread_finalize<Algorithm>)
+      m_algorithm.thread_finalize(m_scratch);
+  }
+
+  thread_scratch(const thread_scratch &) = delete;
+  thread_scratch &operator=(const thread_scratch &) = delete;
+
+  scratch &get() { return m_scratch; }
+
+private:
+  Algorithm &m_algorithm;
+  scratch m_scratch;
+};
+
+} // namespace detail
+} // namespace vecpar
+#endif // VECPAR_SCRATCH_HPP
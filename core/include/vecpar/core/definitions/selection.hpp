@@ -0,0 +1,40 @@
+#ifndef VECPAR_SELECTION_HPP
+#define VECPAR_SELECTION_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <vecmem/containers/vector.hpp>
+
+#include "vecpar/core/definitions/common.hpp"
+
+namespace vecpar::collection {
+
+/// positions (in increasing order) of the elements that passed a filter;
+/// Index has to be wide enough to address every element of the input
+template <typename Index = std::uint32_t>
+using index_vector = vecmem::vector<Index>;
+
+/// one bit per element: bit (i % 64) of word (i / 64) is set
+/// when the i-th element passed a filter
+using bitmask = vecmem::vector<std::uint64_t>;
+
+constexpr std::size_t bitmask_word_bits = 64;
+
+/// number of words needed to store one bit for each of the size elements
+TARGET constexpr std::size_t bitmask_words(std::size_t size) {
+  return (size + bitmask_word_bits - 1) / bitmask_word_bits;
+}
+
+TARGET bool is_set(const bitmask &mask, std::size_t idx) {
+  return (mask[idx / bitmask_word_bits] >> (idx % bitmask_word_bits)) & 1u;
+}
+
+/// value of a selected element together with its position in the input
+template <typename T> struct location {
+  T value;
+  std::size_t index;
+};
+
+} // namespace vecpar::collection
+#endif // VECPAR_SELECTION_HPP
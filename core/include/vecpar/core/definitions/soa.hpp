@@ -0,0 +1,108 @@
+#ifndef VECPAR_SOA_HPP
+#define VECPAR_SOA_HPP
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+#include <vecmem/containers/vector.hpp>
+#include <vecmem/memory/memory_resource.hpp>
+
+#include "vecpar/core/definitions/common.hpp"
+
+namespace vecpar::collection {
+
+/// the fields of one element of a soa_vector, as references into the
+/// arrays of the fields. Only the fields which a mapping function reads or
+/// writes are loaded, so a map over a few fields streams only their arrays.
+/// The fields are accessed with get<I>() or a structured binding:
+///   auto [a, b] = item;  // a and b refer to the fields of item
+template <typename... Fields> class soa_reference {
+public:
+  TARGET explicit soa_reference(Fields &...fields) : m_fields(fields...) {}
+
+  template <std::size_t I> TARGET auto &get() const {
+    return std::get<I>(m_fields);
+  }
+
+  /// all the fields, e.g. for std::apply
+  TARGET const std::tuple<Fields &...> &fields() const { return m_fields; }
+
+private:
+  std::tuple<Fields &...> m_fields;
+};
+
+/// structure of arrays: the element i is made of the i-th items of one
+/// vecmem::vector per field, e.g. soa_vector<int, double> for
+/// struct X { int a; double b; }. operator[] returns a soa_reference.
+template <typename... Fields> class soa_vector {
+public:
+  using value_type = soa_reference<Fields...>;
+  using const_reference = soa_reference<const Fields...>;
+  using soa_fields = std::tuple<Fields...>;
+
+  template <std::size_t I>
+  using field_type = std::tuple_element_t<I, soa_fields>;
+
+  explicit soa_vector(vecmem::memory_resource *mr)
+      : m_fields(vecmem::vector<Fields>(mr)...) {}
+
+  soa_vector(std::size_t size, vecmem::memory_resource *mr)
+      : m_fields(vecmem::vector<Fields>(size, mr)...) {}
+
+  TARGET std::size_t size() const { return std::get<0>(m_fields).size(); }
+
+  void resize(std::size_t size) {
+    std::apply([&](auto &...fields) { (fields.resize(size), ...); },
+               m_fields);
+  }
+
+  /// the array of the I-th field
+  template <std::size_t I> vecmem::vector<field_type<I>> &field() {
+    return std::get<I>(m_fields);
+  }
+
+  template <std::size_t I>
+  const vecmem::vector<field_type<I>> &field() const {
+    return std::get<I>(m_fields);
+  }
+
+  TARGET value_type operator[](std::size_t i) {
+    return std::apply(
+        [&](auto &...fields) { return value_type(fields[i]...); }, m_fields);
+  }
+
+  TARGET const_reference operator[](std::size_t i) const {
+    return std::apply(
+        [&](auto &...fields) { return const_reference(fields[i]...); },
+        m_fields);
+  }
+
+private:
+  std::tuple<vecmem::vector<Fields>...> m_fields;
+};
+
+/// class and member types of a pointer to member, e.g. &X::a
+template <typename M> struct member_pointer_traits;
+
+template <typename S, typename F> struct member_pointer_traits<F S::*> {
+  using class_type = S;
+  using member_type = F;
+};
+
+} // namespace vecpar::collection
+
+namespace vecpar {
+using collection::soa_vector;
+} // namespace vecpar
+
+template <typename... Fields>
+struct std::tuple_size<vecpar::collection::soa_reference<Fields...>>
+    : std::integral_constant<std::size_t, sizeof...(Fields)> {};
+
+template <std::size_t I, typename... Fields>
+struct std::tuple_element<I, vecpar::collection::soa_reference<Fields...>> {
+  using type = std::tuple_element_t<I, std::tuple<Fields...>> &;
+};
+
+#endif // VECPAR_SOA_HPP
@@ -1,6 +1,9 @@
 #ifndef VECPAR_TYPES_HPP
 #define VECPAR_TYPES_HPP
 
+#include <tuple>
+
+#include <vecmem/containers/data/vector_view.hpp>
 #include <vecmem/containers/jagged_vector.hpp>
 #include <vecmem/containers/vector.hpp>
 
@@ -15,9 +18,82 @@ template <typename T>
 concept Jagged_vector_type =
     std::same_as<T, vecmem::jagged_vector<typename T::value_type::value_type>>;
 
-/// check if T is vector or jagged_vector
+/// check if T is a structure of arrays (see soa.hpp)
+template <typename T>
+concept Soa_vector_type = requires { typename T::soa_fields; };
+
+/// check if T is vector, jagged_vector or soa_vector
+template <typename T>
+concept Iterable = Vector_type<T> || Jagged_vector_type<T> ||
+                   Soa_vector_type<T>;
+
+/// check if any of T is a soa_vector; these are host containers, which
+/// only the OpenMP backend accepts (the others reject them with a
+/// static_assert)
+template <typename... T>
+concept Any_soa_vector = (Soa_vector_type<T> || ...);
+
+/// check if T is a lazy range (see lazy.hpp), computed instead of stored
 template <typename T>
-concept Iterable = Vector_type<T> || Jagged_vector_type<T>;
+concept Lazy_range_type = requires { typename T::lazy_range; };
+
+/// check if any of T is a lazy range; its elements are computed on the
+/// host, so only the OpenMP backend accepts them (the others reject them
+/// with a static_assert)
+template <typename... T>
+concept Any_lazy_range = (Lazy_range_type<T> || ...);
+
+/// check if T is a view (see views.hpp) over the storage of a collection
+template <typename T>
+concept View_type = requires { typename T::view_range; };
+
+/// check if T exposes its storage as one contiguous block
+template <typename T>
+concept Contiguous_range = requires(T &t) { t.data(); };
+
+/// check if T is a view over contiguous storage (span_view)
+template <typename T>
+concept Span_view_type = View_type<T> && Contiguous_range<T>;
+
+/// check if any of T is a view without contiguous storage (strided_view);
+/// the CUDA and OpenMP target backends copy or map contiguous storage only,
+/// so they accept span_view but reject these with a static_assert
+template <typename... T>
+concept Any_strided_view = ((View_type<T> && !Contiguous_range<T>) || ...);
+
+/// vecmem view (pointer and size) over the storage of a span_view; a view
+/// over const elements is only read through it
+template <Span_view_type T>
+vecmem::data::vector_view<typename T::value_type> get_span_data(T &view) {
+  using value_t = typename T::value_type;
+  return {static_cast<typename vecmem::data::vector_view<value_t>::size_type>(
+              view.size()),
+          const_cast<value_t *>(view.data())};
+}
+
+/// check that T, the collection that an mmap updates in place, can be
+/// written, i.e. is not a lazy range; the other collections are not checked
+template <typename... T>
+concept Updatable_first =
+    sizeof...(T) > 0 &&
+    !Lazy_range_type<std::tuple_element_t<0, std::tuple<T...>>>;
+
+/// check if T is a flat collection read by position: a vecmem::vector, a
+/// lazy range or a view
+template <typename T>
+concept Flat_collection = Vector_type<T> || Lazy_range_type<T> || View_type<T>;
+
+/// type that the algorithms declare for an input: a lazy range or a view
+/// stands for a vecmem::vector of its elements
+template <typename T> struct declared { using type = T; };
+
+template <typename T>
+requires Lazy_range_type<T> || View_type<T>
+struct declared<T> {
+  using type = vecmem::vector<typename T::value_type>;
+};
+
+template <typename T> using declared_t = typename declared<T>::type;
 
 /// https://stackoverflow.com/questions/62203496/type-trait-to-receive-tvalue-type-if-present-t-otherwise
 template <class T, class = void> struct value_type { using type = T; };
@@ -58,7 +134,8 @@ template <typename... T>
 std::tuple<std::conditional_t<
     (std::is_object<T>::value && Jagged_vector_type<T>),
     vecmem::data::jagged_vector_data<value_type_t<T>>,
-    std::conditional_t<(std::is_object<T>::value && Vector_type<T>),
+    std::conditional_t<(std::is_object<T>::value &&
+                        (Vector_type<T> || Span_view_type<T>)),
                        vecmem::data::vector_view<value_type_t<T>>, T>>...>
 get_view_or_obj(T &...obj) {
   return {([](T &i) {
@@ -68,6 +145,8 @@ get_view_or_obj(T &...obj) {
     } else if constexpr (Vector_type<T>) {
       auto view = vecmem::get_data(i);
       return view;
+    } else if constexpr (Span_view_type<T>) {
+      return get_span_data(i);
     } else {
       return i;
     }
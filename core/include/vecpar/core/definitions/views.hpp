@@ -0,0 +1,90 @@
+#ifndef VECPAR_VIEWS_HPP
+#define VECPAR_VIEWS_HPP
+
+#include <cstddef>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+
+#include <vecmem/containers/vector.hpp>
+
+#include "vecpar/core/definitions/common.hpp"
+#include "vecpar/core/definitions/types.hpp"
+
+namespace vecpar::collection {
+
+/// count consecutive elements of an existing storage
+template <typename T> struct span_view {
+  using value_type = std::remove_cv_t<T>;
+  using view_range = void;
+
+  T *ptr;
+  std::size_t count;
+
+  TARGET std::size_t size() const { return count; }
+  TARGET T *data() const { return ptr; }
+  TARGET T &operator[](std::size_t i) const { return ptr[i]; }
+};
+
+/// count elements of an existing storage, stride positions apart
+template <typename T> struct strided_view {
+  using value_type = std::remove_cv_t<T>;
+  using view_range = void;
+
+  T *ptr;
+  std::size_t count;
+  std::size_t stride;
+
+  TARGET std::size_t size() const { return count; }
+  TARGET T &operator[](std::size_t i) const { return ptr[i * stride]; }
+};
+
+} // namespace vecpar::collection
+
+namespace vecpar {
+
+/// views over a storage which is neither copied nor owned; the viewed
+/// elements have to lie within the storage (std::out_of_range otherwise).
+/// The views are returned const so that temporaries can be passed where the
+/// backends take the collections by reference (the elements stay writable).
+template <typename T>
+const collection::span_view<T> subrange(vecmem::vector<T> &data,
+                                        std::size_t offset,
+                                        std::size_t length) {
+  if (offset > data.size() || length > data.size() - offset)
+    throw std::out_of_range("subrange exceeds the viewed vector");
+  return {data.data() + offset, length};
+}
+
+/// size elements from data, e.g. a buffer of another library
+template <typename T>
+const collection::span_view<T> subrange(T *data, std::size_t size) {
+  if (data == nullptr && size > 0)
+    throw std::invalid_argument("subrange of a null pointer");
+  return {data, size};
+}
+
+/// any other contiguous range (std::vector, std::span, std::array, ...)
+template <typename Range>
+requires std::ranges::contiguous_range<Range> &&
+    std::ranges::sized_range<Range> && std::ranges::borrowed_range<Range>
+const collection::span_view<
+    std::remove_reference_t<std::ranges::range_reference_t<Range>>>
+view(Range &&range) {
+  return {std::ranges::data(range), std::ranges::size(range)};
+}
+
+/// data[offset], data[offset + stride], ... up to the end of data
+template <typename T>
+const collection::strided_view<T>
+strided(vecmem::vector<T> &data, std::size_t offset, std::size_t stride) {
+  if (stride == 0)
+    throw std::invalid_argument("strided view with a zero stride");
+  if (offset > data.size())
+    throw std::out_of_range("strided view starts past the viewed vector");
+  const std::size_t count = (data.size() - offset + stride - 1) / stride;
+  return {data.data() + offset, count, stride};
+}
+
+} // namespace vecpar
+#endif // VECPAR_VIEWS_HPP
@@ -0,0 +1,17 @@
+#ifndef VECPAR_TEST_ALGORITHM_12_HPP
+#define VECPAR_TEST_ALGORITHM_12_HPP
+
+#include <vecmem/containers/jagged_vector.hpp>
+
+#include "vecpar/core/algorithms/parallelizable_filter.hpp"
+#include "vecpar/core/definitions/config.hpp"
+
+class test_algorithm_12 : public vecpar::algorithm::parallelizable_filter<
+                              vecmem::jagged_vector<int>> {
+
+public:
+  TARGET test_algorithm_12() : parallelizable_filter() {}
+
+  TARGET bool filtering_function(int &x) const { return (x % 3 == 0); }
+};
+#endif // VECPAR_TEST_ALGORITHM_12_HPP
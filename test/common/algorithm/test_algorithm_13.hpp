@@ -0,0 +1,20 @@
+#ifndef VECPAR_TEST_ALGORITHM_13_HPP
+#define VECPAR_TEST_ALGORITHM_13_HPP
+
+#include <vecmem/containers/jagged_vector.hpp>
+
+#include "vecpar/core/algorithms/parallelizable_reduce.hpp"
+#include "vecpar/core/definitions/config.hpp"
+
+class test_algorithm_13 : public vecpar::algorithm::parallelizable_reduce<
+                              vecmem::jagged_vector<double>> {
+
+public:
+  TARGET test_algorithm_13() : parallelizable_reduce() {}
+
+  TARGET double *reducing_function(double *result, double &x) const {
+    *result += x;
+    return result;
+  }
+};
+#endif // VECPAR_TEST_ALGORITHM_13_HPP
@@ -0,0 +1,27 @@
+#ifndef VECPAR_TEST_ALGORITHM_14_HPP
+#define VECPAR_TEST_ALGORITHM_14_HPP
+
+#include <span>
+
+#include <vecmem/containers/vector.hpp>
+
+#include "vecpar/core/algorithms/parallelizable_flat_map.hpp"
+#include "vecpar/core/definitions/config.hpp"
+
+/// every input x produces (x % 4) items: x * 10, x * 10 + 1, ...
+class test_algorithm_14
+    : public vecpar::algorithm::parallelizable_flat_map<
+          vecmem::vector<int>, vecmem::vector<int>> {
+
+public:
+  TARGET test_algorithm_14() : parallelizable_flat_map() {}
+
+  TARGET std::size_t count_function(const int &x) const { return x % 4; }
+
+  TARGET void emit_function(__attribute__((unused)) std::size_t idx,
+                            std::span<int> out, const int &x) const {
+    for (std::size_t i = 0; i < out.size(); i++)
+      out[i] = x * 10 + static_cast<int>(i);
+  }
+};
+#endif // VECPAR_TEST_ALGORITHM_14_HPP
@@ -0,0 +1,31 @@
+#ifndef VECPAR_TEST_ALGORITHM_15_HPP
+#define VECPAR_TEST_ALGORITHM_15_HPP
+
+#include <vecmem/containers/jagged_vector.hpp>
+#include <vecmem/containers/vector.hpp>
+
+#include "vecpar/core/algorithms/parallelizable_map.hpp"
+#include "vecpar/core/definitions/config.hpp"
+
+/// same computation as test_algorithm_10, written per inner element
+class test_algorithm_15
+    : public vecpar::algorithm::parallelizable_mmap<
+          Five,
+          /* input collections */
+          vecmem::jagged_vector<double>, vecmem::jagged_vector<double>,
+          vecmem::vector<int>, vecmem::vector<int>, vecmem::jagged_vector<int>,
+          /* other input params */
+          double>,
+      public vecpar::algorithm::elementwise {
+
+public:
+  TARGET test_algorithm_15() : parallelizable_mmap() {}
+
+  TARGET double &mapping_function(double &x, const double &y, const int &z,
+                                  const int &t, const int &v,
+                                  double &a) const {
+    x = a * y + x - z * t * v;
+    return x;
+  }
+};
+#endif // VECPAR_TEST_ALGORITHM_15_HPP
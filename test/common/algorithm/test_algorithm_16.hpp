@@ -0,0 +1,30 @@
+#ifndef VECPAR_TEST_ALGORITHM_16_HPP
+#define VECPAR_TEST_ALGORITHM_16_HPP
+
+#include <vecmem/containers/jagged_vector.hpp>
+#include <vecmem/containers/vector.hpp>
+
+#include "vecpar/core/algorithms/parallelizable_map.hpp"
+#include "vecpar/core/definitions/config.hpp"
+
+class test_algorithm_16
+    : public vecpar::algorithm::parallelizable_map<
+          One,
+          /* result */
+          vecmem::jagged_vector<double>,
+          /* input collection */
+          vecmem::jagged_vector<int>,
+          /* other input params */
+          double>,
+      public vecpar::algorithm::elementwise {
+
+public:
+  TARGET test_algorithm_16() : parallelizable_map() {}
+
+  TARGET double &mapping_function(double &result, const int &x,
+                                  double &a) const {
+    result = a * x;
+    return result;
+  }
+};
+#endif // VECPAR_TEST_ALGORITHM_16_HPP
@@ -0,0 +1,27 @@
+#ifndef VECPAR_TEST_ALGORITHM_17_HPP
+#define VECPAR_TEST_ALGORITHM_17_HPP
+
+#include <vecmem/containers/vector.hpp>
+
+#include "vecpar/core/algorithms/parallelizable_window_reduce.hpp"
+#include "vecpar/core/definitions/config.hpp"
+
+/// moving sum over 5 elements, with a running update
+class test_algorithm_17
+    : public vecpar::algorithm::parallelizable_window_reduce<
+          5, vecmem::vector<double>> {
+
+public:
+  TARGET test_algorithm_17() : parallelizable_window_reduce() {}
+
+  TARGET double *reducing_function(double *result, double &x) const {
+    *result += x;
+    return result;
+  }
+
+  TARGET double *inverse_function(double *result, double &x) const {
+    *result -= x;
+    return result;
+  }
+};
+#endif // VECPAR_TEST_ALGORITHM_17_HPP
@@ -0,0 +1,23 @@
+#ifndef VECPAR_TEST_ALGORITHM_18_HPP
+#define VECPAR_TEST_ALGORITHM_18_HPP
+
+#include <vecmem/containers/vector.hpp>
+
+#include "vecpar/core/algorithms/parallelizable_window_reduce.hpp"
+#include "vecpar/core/definitions/config.hpp"
+
+/// moving maximum over 1000 elements
+class test_algorithm_18
+    : public vecpar::algorithm::parallelizable_window_reduce<
+          1000, vecmem::vector<int>> {
+
+public:
+  TARGET test_algorithm_18() : parallelizable_window_reduce() {}
+
+  TARGET int *reducing_function(int *result, int &x) const {
+    if (x > *result)
+      *result = x;
+    return result;
+  }
+};
+#endif // VECPAR_TEST_ALGORITHM_18_HPP
@@ -0,0 +1,25 @@
+#ifndef VECPAR_TEST_ALGORITHM_19_HPP
+#define VECPAR_TEST_ALGORITHM_19_HPP
+
+#include <vecmem/containers/vector.hpp>
+
+#include "vecpar/core/algorithms/parallelizable_reduce.hpp"
+#include "vecpar/core/definitions/config.hpp"
+
+/// sum of float values, accumulated in double
+class test_algorithm_19
+    : public vecpar::algorithm::parallelizable_transform_reduce<
+          vecmem::vector<float>, double> {
+
+public:
+  TARGET test_algorithm_19() : parallelizable_transform_reduce() {}
+
+  TARGET double identity() const { return 0.0; }
+
+  TARGET void accumulate(double &acc, const float &x) const { acc += x; }
+
+  TARGET void combine(double &acc, const double &partial) const {
+    acc += partial;
+  }
+};
+#endif // VECPAR_TEST_ALGORITHM_19_HPP
@@ -0,0 +1,20 @@
+#ifndef VECPAR_TEST_ALGORITHM_20_HPP
+#define VECPAR_TEST_ALGORITHM_20_HPP
+
+#include <vecmem/containers/vector.hpp>
+
+#include "vecpar/core/algorithms/parallelizable_filter.hpp"
+#include "vecpar/core/definitions/config.hpp"
+
+class test_algorithm_20
+    : public vecpar::algorithm::parallelizable_filter<vecmem::vector<int>> {
+
+public:
+  TARGET test_algorithm_20(int min) : parallelizable_filter(), m_min(min) {}
+
+  TARGET bool filtering_function(int &x) const { return x >= m_min; }
+
+private:
+  int m_min;
+};
+#endif // VECPAR_TEST_ALGORITHM_20_HPP
@@ -0,0 +1,24 @@
+#ifndef VECPAR_TEST_ALGORITHM_21_HPP
+#define VECPAR_TEST_ALGORITHM_21_HPP
+
+#include <cstddef>
+#include <vecmem/containers/vector.hpp>
+
+#include "vecpar/core/algorithms/parallelizable_map.hpp"
+#include "vecpar/core/definitions/config.hpp"
+
+/// the position of the item is passed to the mapping function
+class test_algorithm_21 : public vecpar::algorithm::parallelizable_map<
+                              vecpar::collection::One, vecmem::vector<double>,
+                              vecmem::vector<int>, double> {
+
+public:
+  TARGET test_algorithm_21() : parallelizable_map() {}
+
+  TARGET double &mapping_function(std::size_t idx, double &result_i,
+                                  const int &data_i, double &weight) const {
+    result_i = data_i * weight + idx;
+    return result_i;
+  }
+};
+#endif // VECPAR_TEST_ALGORITHM_21_HPP
@@ -0,0 +1,20 @@
+#ifndef VECPAR_TEST_ALGORITHM_22_HPP
+#define VECPAR_TEST_ALGORITHM_22_HPP
+
+#include <vecmem/containers/vector.hpp>
+
+#include "vecpar/core/algorithms/parallelizable_filter.hpp"
+#include "vecpar/core/definitions/config.hpp"
+
+class test_algorithm_22
+    : public vecpar::algorithm::parallelizable_filter<vecmem::vector<float>> {
+
+public:
+  TARGET test_algorithm_22(float min) : parallelizable_filter(), m_min(min) {}
+
+  TARGET bool filtering_function(float &x) const { return x >= m_min; }
+
+private:
+  float m_min;
+};
+#endif // VECPAR_TEST_ALGORITHM_22_HPP
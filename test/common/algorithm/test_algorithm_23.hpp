@@ -0,0 +1,65 @@
+#ifndef VECPAR_TEST_ALGORITHM_23_HPP
+#define VECPAR_TEST_ALGORITHM_23_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vecmem/containers/vector.hpp>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "vecpar/core/algorithms/parallelizable_map.hpp"
+#include "vecpar/core/definitions/config.hpp"
+#include "vecpar/core/definitions/scratch.hpp"
+
+/// median of a few values computed per item in the scratch of the thread;
+/// the first word of the scratch counts the items of the thread, which are
+/// added to the total when the thread finishes; the size of the team of
+/// threads running the hooks is recorded as well
+class test_algorithm_23 : public vecpar::algorithm::parallelizable_map<
+                              vecpar::collection::One, vecmem::vector<double>,
+                              vecmem::vector<int>> {
+
+public:
+  static constexpr std::size_t window = 3;
+  static constexpr std::size_t scratch_size =
+      sizeof(std::size_t) + window * sizeof(double);
+
+  test_algorithm_23(std::atomic<std::size_t> &threads,
+                    std::atomic<std::size_t> &items,
+                    std::atomic<std::size_t> &team)
+      : parallelizable_map(), m_threads(threads), m_items(items),
+        m_team(team) {}
+
+  void thread_init(vecpar::scratch &s) {
+    m_threads++;
+#ifdef _OPENMP
+    m_team = omp_get_num_threads();
+#endif
+    *s.as<std::size_t>() = 0;
+  }
+
+  void thread_finalize(vecpar::scratch &s) {
+    m_items += *s.as<std::size_t>();
+  }
+
+  double &mapping_function(vecpar::scratch &s, double &result_i,
+                           const int &data_i) const {
+    (*s.as<std::size_t>())++;
+    double *values =
+        reinterpret_cast<double *>(s.as<char>() + sizeof(std::size_t));
+    values[0] = 2.0 * data_i;
+    values[1] = data_i - 1.0;
+    values[2] = data_i;
+    std::sort(values, values + window);
+    result_i = values[1];
+    return result_i;
+  }
+
+private:
+  std::atomic<std::size_t> &m_threads;
+  std::atomic<std::size_t> &m_items;
+  std::atomic<std::size_t> &m_team;
+};
+#endif // VECPAR_TEST_ALGORITHM_23_HPP
@@ -0,0 +1,26 @@
+#ifndef VECPAR_TEST_ALGORITHM_24_HPP
+#define VECPAR_TEST_ALGORITHM_24_HPP
+
+#include <vecmem/containers/vector.hpp>
+
+#include "vecpar/core/algorithms/parallelizable_map.hpp"
+#include "vecpar/core/definitions/config.hpp"
+#include "vecpar/core/definitions/reduced_precision.hpp"
+
+/// saxpy over collections stored in a 16-bit type (vecpar::half or
+/// vecpar::bfloat16) and computed in float
+template <typename Storage>
+class test_algorithm_24
+    : public vecpar::algorithm::parallelizable_mmap<
+          vecpar::collection::Two, vecmem::vector<Storage>,
+          vecmem::vector<Storage>, float> {
+
+public:
+  TARGET test_algorithm_24() = default;
+
+  TARGET float &mapping_function(float &yi, const float &xi, float &a) const {
+    yi = a * xi + yi;
+    return yi;
+  }
+};
+#endif // VECPAR_TEST_ALGORITHM_24_HPP
@@ -0,0 +1,27 @@
+#ifndef VECPAR_TEST_ALGORITHM_25_HPP
+#define VECPAR_TEST_ALGORITHM_25_HPP
+
+#include <vecmem/containers/vector.hpp>
+
+#include "vecpar/core/algorithms/parallelizable_map.hpp"
+#include "vecpar/core/definitions/config.hpp"
+#include "vecpar/core/definitions/soa.hpp"
+
+/// X::f over the fields of X stored as a structure of arrays
+class test_algorithm_25
+    : public vecpar::algorithm::parallelizable_map<
+          vecpar::collection::One, vecmem::vector<double>,
+          vecpar::soa_vector<int, double>> {
+
+public:
+  TARGET test_algorithm_25() : parallelizable_map() {}
+
+  TARGET double &
+  mapping_function(double &out,
+                   vecpar::collection::soa_reference<int, double> x) const {
+    auto [a, b] = x;
+    out = a * b;
+    return out;
+  }
+};
+#endif // VECPAR_TEST_ALGORITHM_25_HPP
@@ -0,0 +1,23 @@
+#ifndef VECPAR_TEST_ALGORITHM_26_HPP
+#define VECPAR_TEST_ALGORITHM_26_HPP
+
+#include "vecpar/core/algorithms/parallelizable_map.hpp"
+#include "vecpar/core/definitions/config.hpp"
+#include "vecpar/core/definitions/soa.hpp"
+
+/// scales the field b of X stored as a structure of arrays, without
+/// touching the field a
+class test_algorithm_26
+    : public vecpar::algorithm::parallelizable_mmap<
+          vecpar::collection::One, vecpar::soa_vector<int, double>, double> {
+
+public:
+  TARGET test_algorithm_26() : parallelizable_mmap() {}
+
+  TARGET double &
+  mapping_function(vecpar::collection::soa_reference<int, double> x,
+                   double &factor) const {
+    return x.get<1>() *= factor;
+  }
+};
+#endif // VECPAR_TEST_ALGORITHM_26_HPP
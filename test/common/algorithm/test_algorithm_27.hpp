@@ -0,0 +1,29 @@
+#ifndef VECPAR_TEST_ALGORITHM_27_HPP
+#define VECPAR_TEST_ALGORITHM_27_HPP
+
+#include <vecmem/containers/vector.hpp>
+
+#include "vecpar/core/algorithms/parallelizable_map.hpp"
+#include "vecpar/core/definitions/config.hpp"
+
+/// weighted sum of seven input columns
+class test_algorithm_27
+    : public vecpar::algorithm::parallelizable_zip_map<
+          vecmem::vector<double>, vecmem::vector<double>,
+          vecmem::vector<double>, vecmem::vector<double>,
+          vecmem::vector<double>, vecmem::vector<double>,
+          vecmem::vector<double>, vecmem::vector<int>, double> {
+
+public:
+  TARGET test_algorithm_27() : parallelizable_zip_map() {}
+
+  TARGET double &mapping_function(double &out, const double &x1,
+                                  const double &x2, const double &x3,
+                                  const double &x4, const double &x5,
+                                  const double &x6, const int &x7,
+                                  double &w) const {
+    out = w * (x1 + x2 + x3 + x4 + x5 + x6 + x7);
+    return out;
+  }
+};
+#endif // VECPAR_TEST_ALGORITHM_27_HPP
@@ -0,0 +1,28 @@
+#ifndef VECPAR_TEST_ALGORITHM_28_HPP
+#define VECPAR_TEST_ALGORITHM_28_HPP
+
+#include <vecmem/containers/vector.hpp>
+
+#include "vecpar/core/algorithms/parallelizable_map.hpp"
+#include "vecpar/core/definitions/config.hpp"
+
+/// adds the products of three pairs of columns to the first collection
+class test_algorithm_28
+    : public vecpar::algorithm::parallelizable_zip_mmap<
+          vecmem::vector<double>, vecmem::vector<double>,
+          vecmem::vector<double>, vecmem::vector<double>,
+          vecmem::vector<double>, vecmem::vector<double>,
+          vecmem::vector<double>> {
+
+public:
+  TARGET test_algorithm_28() : parallelizable_zip_mmap() {}
+
+  TARGET double &mapping_function(double &y, const double &a1,
+                                  const double &b1, const double &a2,
+                                  const double &b2, const double &a3,
+                                  const double &b3) const {
+    y += a1 * b1 + a2 * b2 + a3 * b3;
+    return y;
+  }
+};
+#endif // VECPAR_TEST_ALGORITHM_28_HPP
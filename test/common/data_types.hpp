@@ -12,4 +12,15 @@ struct X {
   TARGET int square_a() const { return a * a; }
 };
 
+struct Point2 {
+  double x = 0;
+  double y = 0;
+
+  TARGET Point2 &operator+=(const Point2 &other) {
+    x += other.x;
+    y += other.y;
+    return *this;
+  }
+};
+
 #endif // VECPAR_DATA_TYPES_HPP
@@ -1,3 +1,10 @@
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include <vecmem/containers/jagged_vector.hpp>
@@ -17,8 +24,29 @@
 #include "../../common/algorithm/test_algorithm_8.hpp"
 
 #include "../../common/algorithm/test_algorithm_10.hpp"
+#include "../../common/algorithm/test_algorithm_12.hpp"
+#include "../../common/algorithm/test_algorithm_13.hpp"
+#include "../../common/algorithm/test_algorithm_14.hpp"
+#include "../../common/algorithm/test_algorithm_15.hpp"
+#include "../../common/algorithm/test_algorithm_16.hpp"
+#include "../../common/algorithm/test_algorithm_17.hpp"
+#include "../../common/algorithm/test_algorithm_18.hpp"
+#include "../../common/algorithm/test_algorithm_19.hpp"
+#include "../../common/algorithm/test_algorithm_20.hpp"
+#include "../../common/algorithm/test_algorithm_21.hpp"
+#include "../../common/algorithm/test_algorithm_22.hpp"
+#include "../../common/algorithm/test_algorithm_23.hpp"
+#include "../../common/algorithm/test_algorithm_24.hpp"
+#include "../../common/algorithm/test_algorithm_25.hpp"
+#include "../../common/algorithm/test_algorithm_26.hpp"
+#include "../../common/algorithm/test_algorithm_27.hpp"
+#include "../../common/algorithm/test_algorithm_28.hpp"
 #include "../../common/algorithm/test_algorithm_9.hpp"
 #include "../../common/infrastructure/cleanup.hpp"
+#include "vecpar/core/algorithms/reducers.hpp"
+#include "vecpar/core/definitions/aligned_memory_resource.hpp"
+#include "vecpar/core/definitions/lazy.hpp"
+#include "vecpar/core/definitions/views.hpp"
 #include "vecpar/omp/omp_parallelization.hpp"
 
 namespace {
@@ -161,6 +189,69 @@ TEST_P(CpuHostMemoryTest, Parallel_Filter_Correctness) {
   }
 }
 
+TEST_P(CpuHostMemoryTest, Parallel_Filter_Indices) {
+  test_algorithm_3 alg(mr);
+
+  vecpar::collection::index_vector<> result =
+      vecpar::omp::parallel_filter_indices(alg, mr, *vec_d);
+
+  int size = vec_d->size() % 2 == 0 ? int(vec_d->size() / 2)
+                                    : int(vec_d->size() / 2) + 1;
+  EXPECT_EQ(result.size(), size);
+
+  // the indices are always in increasing order
+  for (int i = 0; i < result.size(); i++) {
+    EXPECT_EQ(result.at(i), 2 * i);
+  }
+}
+
+TEST_P(CpuHostMemoryTest, Parallel_Filter_Bitmask) {
+  test_algorithm_3 alg(mr);
+
+  vecpar::collection::bitmask result =
+      vecpar::omp::parallel_filter_bitmask(alg, mr, *vec_d);
+
+  EXPECT_EQ(result.size(), vecpar::collection::bitmask_words(vec_d->size()));
+  for (int i = 0; i < vec_d->size(); i++) {
+    EXPECT_EQ(vecpar::collection::is_set(result, i), i % 2 == 0);
+  }
+}
+
+TEST_P(CpuHostMemoryTest, Parallel_MapFilter_Indices_MapSelected) {
+  test_algorithm_3 first_alg(mr);
+  test_algorithm_1 second_alg;
+
+  vecpar::collection::index_vector<std::uint64_t> selection =
+      vecpar::omp::parallel_map_filter_indices<std::uint64_t>(first_alg, mr,
+                                                              *vec);
+  vecmem::vector<double> result =
+      vecpar::omp::parallel_map_selected(second_alg, mr, selection, *vec);
+
+  EXPECT_EQ(result.size(), selection.size());
+  for (int i = 0; i < result.size(); i++) {
+    EXPECT_EQ(result.at(i), vec->at(2 * i) * 1.0);
+  }
+}
+
+TEST_P(CpuHostMemoryTest, Parallel_Filter_In_Place) {
+  test_algorithm_3 alg(mr);
+
+  vecmem::vector<double> data(*vec_d, &mr);
+  vecpar::config c{2, 5};
+  vecmem::vector<double> &result =
+      vecpar::omp::parallel_filter_in_place(alg, mr, c, data);
+
+  EXPECT_EQ(&result, &data);
+  int size = vec_d->size() % 2 == 0 ? int(vec_d->size() / 2)
+                                    : int(vec_d->size() / 2) + 1;
+  EXPECT_EQ(result.size(), size);
+
+  // the compaction keeps the original order
+  for (int i = 0; i < result.size(); i++) {
+    EXPECT_EQ(result.at(i), vec_d->at(2 * i));
+  }
+}
+
 TEST_P(CpuHostMemoryTest, Serial_MapReduce) {
   test_algorithm_1 alg;
 
@@ -423,6 +514,48 @@ TEST_P(CpuHostMemoryTest, five_collections) {
   cleanup::free(result);
 }
 
+TEST_P(CpuHostMemoryTest, five_collections_in_place) {
+  test_algorithm_9 alg;
+
+  vecmem::vector<double> x(GetParam(), &mr);
+  vecmem::vector<int> y(GetParam(), &mr);
+  vecmem::vector<float> z(GetParam(), &mr);
+  vecmem::vector<float> t(GetParam(), &mr);
+  vecmem::vector<int> v(GetParam(), &mr);
+
+  vecmem::vector<double> expected;
+
+  float a = 2.0;
+  for (int i = 0; i < x.size(); i++) {
+    x[i] = i;
+    y[i] = 1;
+    z[i] = -1.0;
+    t[i] = (i % 3 == 0) ? 4.0 * i : 0.5;
+    v[i] = i - 1;
+    // as map is implemented in algorithm 9
+    double tmp = x[i] * a + y[i] * z[i] * t[i] + v[i];
+    // as filter is implemented in algorithm 9
+    if (tmp > 0)
+      expected.push_back(tmp);
+  }
+
+  vecmem::vector<double> &result =
+      vecpar::omp::parallel_map_filter_in_place(alg, mr, x, y, z, t, v, a);
+
+  EXPECT_EQ(&result, &x);
+  EXPECT_EQ(result.size(), expected.size());
+  for (int i = 0; i < result.size(); i++) {
+    EXPECT_EQ(result.at(i), expected.at(i));
+  }
+
+  cleanup::free(x);
+  cleanup::free(y);
+  cleanup::free(z);
+  cleanup::free(t);
+  cleanup::free(v);
+  cleanup::free(expected);
+}
+
 TEST_P(CpuHostMemoryTest, five_jagged) {
   std::chrono::time_point<std::chrono::steady_clock> start_time;
   std::chrono::time_point<std::chrono::steady_clock> end_time;
@@ -473,6 +606,959 @@ TEST_P(CpuHostMemoryTest, five_jagged) {
   cleanup::free(expected);
 }
 
+TEST_P(CpuHostMemoryTest, Parallel_Filter_Jagged) {
+  test_algorithm_12 alg;
+
+  // rows of different (and zero) lengths
+  vecmem::jagged_vector<int> x(GetParam(), &mr);
+  for (int i = 0; i < GetParam(); i++)
+    for (int j = 0; j < i % 7; j++)
+      x[i].push_back(i + j);
+
+  vecpar::config c{2, 3};
+  vecmem::jagged_vector<int> result =
+      vecpar::omp::parallel_filter(alg, mr, c, x);
+
+  EXPECT_EQ(result.size(), x.size());
+  for (int i = 0; i < GetParam(); i++) {
+    vecmem::vector<int> expected(&mr);
+    for (int j = 0; j < i % 7; j++)
+      if ((i + j) % 3 == 0)
+        expected.push_back(i + j);
+    EXPECT_EQ(result[i].size(), expected.size());
+    for (int j = 0; j < result[i].size(); j++)
+      EXPECT_EQ(result[i][j], expected[j]);
+  }
+
+  cleanup::free(x);
+  cleanup::free(result);
+}
+
+TEST_P(CpuHostMemoryTest, Parallel_Reduce_Jagged) {
+  test_algorithm_13 alg;
+
+  vecmem::jagged_vector<double> x(GetParam(), &mr);
+  double expected = 0;
+  for (int i = 0; i < GetParam(); i++)
+    for (int j = 0; j < i % 7; j++) {
+      x[i].push_back(j * 1.0);
+      expected += j * 1.0;
+    }
+
+  vecpar::config c{2, 3};
+  double result = vecpar::omp::parallel_reduce(alg, mr, c, x);
+  EXPECT_EQ(result, expected);
+
+  vecmem::vector<double> rows =
+      vecpar::omp::parallel_reduce_rows(alg, mr, c, x);
+  EXPECT_EQ(rows.size(), x.size());
+  for (int i = 0; i < GetParam(); i++)
+    EXPECT_EQ(rows[i], (i % 7) * (i % 7 - 1) / 2 * 1.0);
+
+  cleanup::free(x);
+}
+
+TEST_P(CpuHostMemoryTest, Parallel_Flat_Map) {
+  test_algorithm_14 alg;
+
+  vecmem::vector<int> expected(&mr);
+  for (int i = 0; i < vec->size(); i++)
+    for (int j = 0; j < vec->at(i) % 4; j++)
+      expected.push_back(vec->at(i) * 10 + j);
+
+  vecmem::vector<int> result = vecpar::omp::parallel_flat_map(alg, mr, *vec);
+
+  // exactly sized and in the order of the inputs
+  EXPECT_EQ(result.size(), expected.size());
+  for (int i = 0; i < result.size(); i++)
+    EXPECT_EQ(result[i], expected[i]);
+
+  vecpar::config c{2, 3};
+  vecpar::collection::csr_vector<int> &grouped =
+      vecpar::omp::parallel_flat_map_jagged(alg, mr, c, *vec);
+  EXPECT_EQ(grouped.size(), vec->size());
+  EXPECT_EQ(grouped.values.size(), expected.size());
+  for (int i = 0; i < vec->size(); i++) {
+    EXPECT_EQ(grouped.offsets[i + 1] - grouped.offsets[i], vec->at(i) % 4);
+    EXPECT_EQ(grouped.rows[i].size(), vec->at(i) % 4);
+    for (int j = 0; j < grouped[i].size(); j++)
+      EXPECT_EQ(grouped[i][j], vec->at(i) * 10 + j);
+  }
+  // the rows are stored back to back, as the flat result
+  for (int i = 0; i < result.size(); i++)
+    EXPECT_EQ(grouped.values[i], expected[i]);
+
+  cleanup::free(result);
+  delete &grouped;
+}
+
+TEST_P(CpuHostMemoryTest, five_jagged_elementwise) {
+  test_algorithm_15 alg;
+
+  vecmem::jagged_vector<double> x(GetParam(), &mr);
+  vecmem::jagged_vector<double> y(GetParam(), &mr);
+  vecmem::vector<int> z(GetParam(), &mr);
+  vecmem::vector<int> t(GetParam(), &mr);
+  vecmem::jagged_vector<int> v(GetParam(), &mr);
+
+  double a = 2.0;
+
+  // rows of very different lengths
+  vecmem::jagged_vector<double> expected(GetParam(), &mr);
+  for (int i = 0; i < GetParam(); i++) {
+    z[i] = -i;
+    t[i] = -2;
+    const int n = (i % 10 == 0) ? 50 : i % 3;
+    for (int j = 0; j < n; j++) {
+      x[i].push_back(1);
+      y[i].push_back(i);
+      v[i].push_back(j);
+      expected[i].push_back(a * y[i][j] + x[i][j] - z[i] * t[i] * v[i][j]);
+    }
+  }
+
+  vecpar::config c{2, 3};
+  vecpar::omp::parallel_map(alg, mr, c, x, y, z, t, v, a);
+
+  for (int i = 0; i < GetParam(); i++) {
+    EXPECT_EQ(x[i].size(), expected[i].size());
+    for (int j = 0; j < x[i].size(); j++) {
+      EXPECT_EQ(x[i][j], expected[i][j]);
+    }
+  }
+
+  cleanup::free(x);
+  cleanup::free(y);
+  cleanup::free(z);
+  cleanup::free(t);
+  cleanup::free(v);
+  cleanup::free(expected);
+}
+
+TEST_P(CpuHostMemoryTest, jagged_elementwise_shape_mismatch) {
+  test_algorithm_15 alg;
+
+  vecmem::jagged_vector<double> x(GetParam(), &mr);
+  vecmem::jagged_vector<double> y(GetParam(), &mr);
+  vecmem::vector<int> z(GetParam(), &mr);
+  vecmem::vector<int> t(GetParam(), &mr);
+  vecmem::jagged_vector<int> v(GetParam(), &mr);
+  for (int i = 0; i < GetParam(); i++)
+    for (int j = 0; j < i % 3; j++) {
+      x[i].push_back(1);
+      y[i].push_back(i);
+      v[i].push_back(j);
+    }
+  double a = 2.0;
+  vecpar::config c{2, 3};
+
+  // a row of y is longer than the row of x
+  y.back().push_back(0);
+  EXPECT_THROW(vecpar::omp::parallel_map(alg, mr, c, x, y, z, t, v, a),
+               std::length_error);
+  y.back().pop_back();
+
+  // v has one row more than x
+  v.emplace_back();
+  EXPECT_THROW(vecpar::omp::parallel_map(alg, mr, c, x, y, z, t, v, a),
+               std::length_error);
+
+  // nothing was written
+  for (int i = 0; i < GetParam(); i++)
+    for (int j = 0; j < x[i].size(); j++)
+      EXPECT_EQ(x[i][j], 1);
+
+  cleanup::free(x);
+  cleanup::free(y);
+  cleanup::free(z);
+  cleanup::free(t);
+  cleanup::free(v);
+}
+
+TEST_P(CpuHostMemoryTest, Parallel_Map_Jagged_CSR) {
+  test_algorithm_16 alg;
+
+  vecmem::jagged_vector<int> x(GetParam(), &mr);
+  for (int i = 0; i < GetParam(); i++)
+    for (int j = 0; j < i % 5; j++)
+      x[i].push_back(i + j);
+  double a = 0.5;
+
+  vecpar::collection::csr_vector<double> &result =
+      vecpar::omp::parallel_map_csr(alg, mr, x, a);
+
+  EXPECT_EQ(result.size(), x.size());
+  EXPECT_EQ(result.offsets.size(), x.size() + 1);
+  for (int i = 0; i < GetParam(); i++) {
+    EXPECT_EQ(result[i].size(), x[i].size());
+    for (int j = 0; j < x[i].size(); j++)
+      EXPECT_EQ(result[i][j], a * x[i][j]);
+  }
+
+  // the rows can also be consumed through a jagged vector view
+  vecmem::data::jagged_vector_view<double> view = result.get_data();
+  EXPECT_EQ(view.size(), x.size());
+  for (int i = 0; i < GetParam(); i++) {
+    EXPECT_EQ(view.ptr()[i].size(), x[i].size());
+    for (int j = 0; j < x[i].size(); j++)
+      EXPECT_EQ(view.ptr()[i].ptr()[j], a * x[i][j]);
+  }
+
+  cleanup::free(x);
+  delete &result;
+}
+
+TEST_P(CpuHostMemoryTest, Parallel_Window_Reduce_Sum) {
+  test_algorithm_17 alg;
+
+  vecpar::config c{2, 3};
+  vecmem::vector<double> result =
+      vecpar::omp::parallel_window_reduce(alg, mr, c, *vec_d);
+
+  const int W = 5;
+  EXPECT_EQ(result.size(), vec_d->size() < W ? 0 : vec_d->size() - W + 1);
+  for (int i = 0; i < result.size(); i++) {
+    double expected = 0;
+    for (int j = i; j < i + W; j++)
+      expected += vec_d->at(j);
+    EXPECT_EQ(result[i], expected);
+  }
+}
+
+TEST_P(CpuHostMemoryTest, Parallel_Window_Reduce_Max) {
+  test_algorithm_18 alg;
+
+  // zig-zag values, so that the maximum is not always at the window end
+  vecmem::vector<int> x(GetParam(), &mr);
+  for (int i = 0; i < x.size(); i++)
+    x[i] = (i * 7919) % 1543;
+
+  vecmem::vector<int> result = vecpar::omp::parallel_window_reduce(alg, mr, x);
+
+  const int W = 1000;
+  EXPECT_EQ(result.size(), x.size() < W ? 0 : x.size() - W + 1);
+  for (int i = 0; i < result.size(); i += 97) {
+    int expected = x[i];
+    for (int j = i; j < i + W; j++)
+      expected = std::max(expected, x[j]);
+    EXPECT_EQ(result[i], expected);
+  }
+
+  cleanup::free(x);
+}
+
+TEST_P(CpuHostMemoryTest, Parallel_Reduce_Tuple) {
+  namespace reducers = vecpar::reducers;
+
+  auto [s, mn, mx, n] = vecpar::omp::parallel_reduce(
+      reducers::tuple<reducers::sum, reducers::min, reducers::max,
+                      reducers::count>(),
+      mr, *vec_d);
+
+  EXPECT_EQ(s, expectedReduceResult);
+  EXPECT_EQ(mn, 0.0);
+  EXPECT_EQ(mx, vec_d->size() - 1.0);
+  EXPECT_EQ(n, vec_d->size());
+}
+
+TEST_P(CpuHostMemoryTest, Parallel_MapReduce_Tuple) {
+  namespace reducers = vecpar::reducers;
+  test_algorithm_1 alg;
+
+  // built-in reducers and a reducing_function algorithm, fused with the map
+  vecpar::config c{2, 3};
+  auto [s, mx, legacy] = vecpar::omp::parallel_map_reduce(
+      alg, reducers::tuple<reducers::sum, reducers::max, test_algorithm_1>(),
+      mr, c, *vec);
+
+  EXPECT_EQ(s, expectedReduceResult);
+  EXPECT_EQ(mx, vec->size() - 1.0);
+  EXPECT_EQ(legacy, expectedReduceResult);
+}
+
+TEST_P(CpuHostMemoryTest, Parallel_Transform_Reduce) {
+  test_algorithm_19 alg;
+
+  vecmem::vector<float> x(GetParam(), &mr);
+  for (int i = 0; i < x.size(); i++)
+    x[i] = static_cast<float>(i);
+
+  // the sum is exact in double, but not in float
+  double result = vecpar::omp::parallel_reduce(alg, mr, x);
+  EXPECT_EQ(result, expectedReduceResult);
+
+  cleanup::free(x);
+}
+
+TEST_P(CpuHostMemoryTest, Parallel_Reduce_Compensated) {
+  // one large value followed by many small ones which a plain
+  // (per-thread) summation in double partially loses
+  vecmem::vector<double> x(GetParam(), 0.1, &mr);
+  x[0] = 1e15;
+  const double expected = 1e15 + (GetParam() - 1) * 0.1;
+
+  vecpar::config c{2, 3};
+  double kahan =
+      vecpar::omp::parallel_reduce(vecpar::reducers::kahan_sum(), mr, c, x);
+  double plain =
+      vecpar::omp::parallel_reduce(vecpar::reducers::sum(), mr, c, x);
+
+  EXPECT_NEAR(kahan, expected, 0.25);
+  EXPECT_LE(std::abs(kahan - expected), std::abs(plain - expected));
+
+  // the error of the pairwise summation grows only with log(size)
+  x[0] = 0.1;
+  long double exact = 0;
+  for (int i = 0; i < x.size(); i++)
+    exact += x[i];
+  double pairwise =
+      vecpar::omp::parallel_reduce(vecpar::reducers::pairwise_sum(), mr, c, x);
+  EXPECT_NEAR(pairwise, static_cast<double>(exact), 1e-13 * x.size());
+
+  cleanup::free(x);
+}
+
+TEST_P(CpuHostMemoryTest, Parallel_Reduce_Native) {
+  namespace reducers = vecpar::reducers;
+
+  vecpar::config c{2, 3};
+  EXPECT_EQ(vecpar::omp::parallel_reduce(reducers::plus(), mr, c, *vec_d),
+            expectedReduceResult);
+  EXPECT_EQ(vecpar::omp::parallel_reduce(reducers::min(), mr, *vec), 0);
+  EXPECT_EQ(vecpar::omp::parallel_reduce(reducers::max(), mr, *vec),
+            vec->size() - 1);
+
+  int expected_and = ~0, expected_or = 0, expected_xor = 0;
+  vecmem::vector<int> factors(GetParam(), 1, &mr);
+  for (int i = 0; i < vec->size(); i++) {
+    expected_and &= vec->at(i) | 8;
+    expected_or |= vec->at(i);
+    expected_xor ^= vec->at(i);
+  }
+  factors[0] = 3;
+  factors[GetParam() - 1] = -2;
+
+  EXPECT_EQ(vecpar::omp::parallel_reduce(reducers::multiplies(), mr, factors),
+            GetParam() == 1 ? -2 : -6);
+  EXPECT_EQ(vecpar::omp::parallel_reduce(reducers::bit_or(), mr, *vec),
+            expected_or);
+  EXPECT_EQ(vecpar::omp::parallel_reduce(reducers::bit_xor(), mr, *vec),
+            expected_xor);
+
+  for (int i = 0; i < vec->size(); i++)
+    factors[i] = vec->at(i) | 8;
+  EXPECT_EQ(vecpar::omp::parallel_reduce(reducers::bit_and(), mr, factors),
+            expected_and);
+
+  // not an arithmetic type: reduction declared from the reducer
+  vecmem::vector<Point2> points(GetParam(), &mr);
+  for (int i = 0; i < points.size(); i++)
+    points[i] = {i * 1.0, 1.0};
+  Point2 p = vecpar::omp::parallel_reduce(reducers::plus(), mr, c, points);
+  EXPECT_EQ(p.x, expectedReduceResult);
+  EXPECT_EQ(p.y, points.size() * 1.0);
+
+  cleanup::free(factors);
+  cleanup::free(points);
+}
+
+TEST_P(CpuHostMemoryTest, Parallel_Top_K) {
+  vecmem::vector<int> scores(GetParam(), &mr);
+  for (int i = 0; i < scores.size(); i++)
+    scores[i] = (i * 37) % 101;
+  std::vector<int> sorted(scores.begin(), scores.end());
+  std::sort(sorted.begin(), sorted.end(), std::greater<>());
+
+  // sorted arrays (small k), bounded heaps, k larger than the chunks and
+  // the parallel selection for large k
+  vecpar::config c{2, 3};
+  for (std::size_t k : {5, 40, 500, 5000, 60000}) {
+    vecmem::vector<int> &best =
+        vecpar::omp::parallel_top_k(k, std::greater<>(), mr, c, scores);
+    ASSERT_EQ(best.size(), std::min<std::size_t>(k, scores.size()));
+    for (int i = 0; i < best.size(); i++)
+      EXPECT_EQ(best[i], sorted[i]);
+    cleanup::free(best);
+  }
+
+  // fused with a map
+  test_algorithm_1 alg;
+  vecmem::vector<double> &largest =
+      vecpar::omp::parallel_map_top_k(alg, 3, std::greater<>(), mr, *vec);
+  for (int i = 0; i < largest.size(); i++)
+    EXPECT_EQ(largest[i], vec->size() - 1.0 - i);
+
+  cleanup::free(scores);
+  cleanup::free(largest);
+}
+
+TEST_P(CpuHostMemoryTest, Parallel_Arg_Min_Max) {
+  vecmem::vector<int> scores(GetParam(), &mr);
+  for (int i = 0; i < scores.size(); i++)
+    scores[i] = (i * 37) % 101;
+  auto min_it = std::min_element(scores.begin(), scores.end());
+  auto max_it = std::max_element(scores.begin(), scores.end());
+
+  // the first occurrence wins
+  vecpar::config c{2, 3};
+  vecpar::collection::location<int> min =
+      vecpar::omp::parallel_arg_min(mr, c, scores);
+  vecpar::collection::location<int> max =
+      vecpar::omp::parallel_arg_max(mr, scores);
+  EXPECT_EQ(min.value, *min_it);
+  EXPECT_EQ(min.index, min_it - scores.begin());
+  EXPECT_EQ(max.value, *max_it);
+  EXPECT_EQ(max.index, max_it - scores.begin());
+
+  test_algorithm_1 alg;
+  vecpar::collection::location<double> mapped =
+      vecpar::omp::parallel_map_arg_max(alg, mr, c, *vec);
+  EXPECT_EQ(mapped.value, vec->size() - 1.0);
+  EXPECT_EQ(mapped.index, vec->size() - 1);
+  mapped = vecpar::omp::parallel_map_arg_min(alg, mr, *vec);
+  EXPECT_EQ(mapped.index, 0);
+
+  cleanup::free(scores);
+}
+
+TEST_P(CpuHostMemoryTest, Parallel_Search) {
+  const int size = vec->size();
+  vecpar::config c{2, 3};
+
+  test_algorithm_20 upper_half(size / 2);
+  EXPECT_EQ(vecpar::omp::parallel_find_first(upper_half, c, *vec), size / 2);
+  EXPECT_TRUE(vecpar::omp::parallel_any_of(upper_half, *vec));
+  EXPECT_FALSE(vecpar::omp::parallel_all_of(upper_half, c, *vec));
+  EXPECT_EQ(vecpar::omp::parallel_count_if(upper_half, c, *vec),
+            size - size / 2);
+
+  test_algorithm_20 all(0);
+  EXPECT_EQ(vecpar::omp::parallel_find_first(all, *vec), 0);
+  EXPECT_TRUE(vecpar::omp::parallel_all_of(all, *vec));
+  EXPECT_EQ(vecpar::omp::parallel_count_if(all, *vec), size);
+
+  test_algorithm_20 none(size);
+  EXPECT_EQ(vecpar::omp::parallel_find_first(none, c, *vec), size);
+  EXPECT_FALSE(vecpar::omp::parallel_any_of(none, c, *vec));
+  EXPECT_EQ(vecpar::omp::parallel_count_if(none, *vec), 0);
+}
+
+TEST_P(CpuHostMemoryTest, Parallel_Map_Indexed) {
+  test_algorithm_21 alg;
+  double weight = 2.0;
+
+  vecpar::config c{2, 3};
+  vecmem::vector<double> &result =
+      vecpar::omp::parallel_map(alg, mr, c, *vec, weight);
+  for (int i = 0; i < result.size(); i++)
+    EXPECT_EQ(result[i], 3.0 * i);
+
+  // the fused forms see the same positions
+  double total = vecpar::omp::parallel_map_reduce(
+      alg, vecpar::reducers::sum(), mr, *vec, weight);
+  EXPECT_EQ(total, 3.0 * expectedReduceResult);
+
+  cleanup::free(result);
+}
+
+TEST_P(CpuHostMemoryTest, Parallel_Map_Scratch) {
+  std::atomic<std::size_t> threads = 0;
+  std::atomic<std::size_t> items = 0;
+  std::atomic<std::size_t> team = 0;
+  test_algorithm_23 alg(threads, items, team);
+
+  vecpar::config c{2, 3, test_algorithm_23::scratch_size};
+  vecmem::vector<double> &result = vecpar::omp::parallel_map(alg, mr, c, *vec);
+  for (int i = 0; i < result.size(); i++)
+    EXPECT_EQ(result[i], i * 1.0);
+  // the hooks run once per thread of the team (which may be smaller than
+  // the 6 threads asked for), around all the items of the thread
+  EXPECT_GE(team, 1);
+  EXPECT_LE(team, 6);
+  EXPECT_EQ(threads, team);
+  EXPECT_EQ(items, vec->size());
+
+  // a scratch which cannot be allocated throws on the calling thread,
+  // before the parallel region
+  vecpar::config too_large{2, 3, std::size_t(1) << 60};
+  EXPECT_THROW(vecpar::omp::parallel_map(alg, mr, too_large, *vec),
+               std::bad_alloc);
+
+  cleanup::free(result);
+}
+
+TEST_P(CpuHostMemoryTest, Parallel_Map_Reduced_Precision) {
+  test_algorithm_24<vecpar::half> saxpy;
+  vecmem::vector<vecpar::half> x(GetParam(), &mr);
+  vecmem::vector<vecpar::half> y(GetParam(), &mr);
+  float a = 2.0;
+  double expected = 0;
+  for (int i = 0; i < x.size(); i++) {
+    x[i] = i % 64;
+    y[i] = 0.5f;
+    expected += a * (i % 64) + 0.5;
+  }
+  // the items are widened to float for the mapping function
+  vecpar::omp::parallel_map(saxpy, mr, y, x, a);
+  for (int i = 0; i < y.size(); i++)
+    EXPECT_EQ(float(y[i]), a * (i % 64) + 0.5f);
+
+  // and summed in double: every item and partial sum is exact
+  double total = vecpar::omp::parallel_reduce(vecpar::reducers::sum(), mr, y);
+  EXPECT_EQ(total, expected);
+  EXPECT_EQ(vecpar::omp::parallel_reduce(vecpar::reducers::max(), mr, y),
+            y.size() < 64 ? a * (y.size() - 1) + 0.5f : 126.5f);
+
+  // bfloat16 keeps the range of float with 8 bits of precision
+  test_algorithm_24<vecpar::bfloat16> bf_saxpy;
+  vecmem::vector<vecpar::bfloat16> bx(GetParam(), 1.0f, &mr);
+  vecmem::vector<vecpar::bfloat16> by(GetParam(), 1.0e30f, &mr);
+  float b = 1.0e30f;
+  vecpar::omp::parallel_map(bf_saxpy, mr, by, bx, b);
+  for (int i = 0; i < by.size(); i++)
+    EXPECT_NEAR(float(by[i]), 2.0e30f, 2.0e30f / 128);
+
+  EXPECT_EQ(float(vecpar::half(65519.0f)), 65504.0f);
+  EXPECT_EQ(float(vecpar::half(1.0e-8f)), 0.0f);
+  EXPECT_EQ(float(vecpar::bfloat16(1.00390625f)), 1.0f);
+
+  cleanup::free(x);
+  cleanup::free(y);
+  cleanup::free(bx);
+  cleanup::free(by);
+}
+
+TEST_P(CpuHostMemoryTest, Parallel_Map_Streaming_Stores) {
+  test_algorithm_1 alg;
+
+  // opt-in only
+  EXPECT_EQ(vecpar::config().m_storeHint, vecpar::store_hint::regular);
+  vecpar::config c{2, 3};
+  c.m_storeHint = vecpar::store_hint::streaming;
+  vecmem::vector<double> &result = vecpar::omp::parallel_map(alg, mr, c, *vec);
+  ASSERT_EQ(result.size(), vec->size());
+  for (int i = 0; i < result.size(); i++)
+    EXPECT_EQ(result[i], i * 1.0);
+
+  // a destination which does not start at a cache line
+  std::vector<double> buffer(vec->size() + 3, -1.0);
+  vecpar::omp::parallel_map_into(
+      alg, vecpar::subrange(buffer.data() + 3, vec->size()), c, *vec);
+  for (int i = 0; i < 3; i++)
+    EXPECT_EQ(buffer[i], -1.0);
+  for (int i = 0; i < vec->size(); i++)
+    EXPECT_EQ(buffer[i + 3], i * 1.0);
+
+  cleanup::free(result);
+}
+
+TEST_P(CpuHostMemoryTest, Parallel_Map_Automatic_Stores) {
+  test_algorithm_1 alg;
+
+  vecpar::config c{1, 2};
+  c.m_storeHint = vecpar::store_hint::automatic;
+  const std::size_t threshold = internal::streaming_store_threshold();
+  EXPECT_FALSE(internal::use_streaming_stores(c, threshold - 1));
+  EXPECT_TRUE(internal::use_streaming_stores(c, threshold));
+  // a single thread does not stream
+  vecpar::config single{1, 1};
+  single.m_storeHint = vecpar::store_hint::automatic;
+  EXPECT_FALSE(internal::use_streaming_stores(single, threshold));
+
+  // below the threshold, automatic writes with regular stores
+  vecmem::vector<double> &result = vecpar::omp::parallel_map(alg, mr, c, *vec);
+  ASSERT_EQ(result.size(), vec->size());
+  for (int i = 0; i < result.size(); i++)
+    EXPECT_EQ(result[i], i * 1.0);
+
+  cleanup::free(result);
+}
+
+TEST_P(CpuHostMemoryTest, Aligned_Memory_Resource) {
+  vecpar::aligned_memory_resource aligned_mr;
+  test_algorithm_1 map;
+  test_algorithm_6 axpy;
+  // 4 threads, so that the ranges of the threads start at cache lines
+  vecpar::config c{1, 4};
+
+  vecmem::vector<int> data(*vec, &aligned_mr);
+  vecmem::vector<float> x(GetParam(), &aligned_mr);
+  vecmem::vector<float> y(GetParam(), &aligned_mr);
+  EXPECT_TRUE(aligned_mr.is_aligned(data.data()));
+  EXPECT_TRUE(aligned_mr.is_aligned(x.data()));
+  EXPECT_TRUE(aligned_mr.is_aligned(y.data()));
+
+  for (int i = 0; i < GetParam(); i++) {
+    x[i] = i;
+    y[i] = 1.0;
+  }
+  float a = 2.0;
+  // the scalar a is passed through, only y and x have to be aligned
+  static_assert(internal::is_aligned_mmap<test_algorithm_6,
+                                          vecmem::vector<float>,
+                                          vecmem::vector<float>, float>);
+  vecpar::omp::parallel_map(axpy, aligned_mr, c, y, x, a);
+  for (int i = 0; i < GetParam(); i++) {
+    EXPECT_EQ(y[i], x[i] * a + 1.0);
+  }
+
+  // map with an object argument
+  test_algorithm_2 scaled;
+  X factor{2, 1.5};
+  static_assert(internal::is_aligned_map<test_algorithm_2,
+                                         vecmem::vector<double>,
+                                         vecmem::vector<int>, X>);
+  vecmem::vector<double> &scaled_result =
+      vecpar::omp::parallel_map(scaled, aligned_mr, c, data, factor);
+  for (int i = 0; i < GetParam(); i++) {
+    EXPECT_EQ(scaled_result[i], vec->at(i) * 3.0);
+  }
+  delete &scaled_result;
+
+  vecmem::vector<double> &result =
+      vecpar::omp::parallel_map(map, aligned_mr, c, data);
+  EXPECT_TRUE(aligned_mr.is_aligned(result.data()));
+  for (int i = 0; i < GetParam(); i++) {
+    EXPECT_EQ(result[i], vec->at(i));
+  }
+  delete &result;
+
+  // in place over an aligned collection, with ranges split at cache lines
+  test_algorithm_4 twice;
+  vecmem::vector<double> z(GetParam(), &aligned_mr);
+  for (int i = 0; i < GetParam(); i++)
+    z[i] = i;
+  vecpar::omp::parallel_map(twice, aligned_mr, c, z);
+  for (int i = 0; i < GetParam(); i++) {
+    EXPECT_EQ(z[i], 2.0 * i);
+  }
+
+  EXPECT_THROW(vecpar::aligned_memory_resource(48), std::invalid_argument);
+
+  // from 2 MiB on the memory is mapped at a huge page boundary
+  vecpar::aligned_memory_resource huge_mr(
+      128, vecpar::aligned_memory_resource::huge_pages::explicit_pool);
+  void *p = huge_mr.allocate(vecpar::aligned_memory_resource::huge_page_size);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) %
+                vecpar::aligned_memory_resource::huge_page_size,
+            0u);
+  static_cast<char *>(p)[0] = 1;
+  huge_mr.deallocate(p, vecpar::aligned_memory_resource::huge_page_size);
+}
+
+TEST_P(CpuHostMemoryTest, Parallel_Container_Initialization) {
+  const std::size_t n = GetParam();
+  vecpar::aligned_memory_resource aligned_mr;
+
+  vecmem::vector<double> &filled =
+      vecpar::omp::parallel_make_vector<double>(aligned_mr, n, 1.5);
+  EXPECT_EQ(filled.size(), n);
+  EXPECT_EQ(filled.get_allocator().resource(), &aligned_mr);
+  EXPECT_TRUE(aligned_mr.is_aligned(filled.data()));
+  for (std::size_t i = 0; i < n; i++) {
+    EXPECT_EQ(filled[i], 1.5);
+  }
+
+  vecmem::vector<int> iota(n, &mr);
+  vecpar::omp::parallel_iota(iota, 3);
+  vecpar::omp::parallel_generate(
+      filled, [](std::size_t i) { return (i % 100) * 0.5; });
+  for (std::size_t i = 0; i < n; i++) {
+    EXPECT_EQ(iota[i], int(i) + 3);
+    EXPECT_EQ(filled[i], (i % 100) * 0.5);
+  }
+
+  // streaming stores, into a container which grows
+  vecpar::config c = vecpar::omp::getDefaultConfig();
+  c.m_storeHint = vecpar::store_hint::streaming;
+  std::vector<int> copy;
+  vecpar::omp::parallel_copy(c, iota, copy);
+  EXPECT_EQ(copy.size(), n);
+  vecpar::omp::parallel_fill(c, iota, -1);
+  for (std::size_t i = 0; i < n; i++) {
+    EXPECT_EQ(copy[i], int(i) + 3);
+    EXPECT_EQ(iota[i], -1);
+  }
+  delete &filled;
+
+  // rows of 0, 1, ..., 9 items
+  std::vector<std::size_t> sizes(n % 10 + 10);
+  for (std::size_t i = 0; i < sizes.size(); i++)
+    sizes[i] = i % 10;
+  vecpar::collection::csr_vector<float> &jagged =
+      vecpar::omp::parallel_make_jagged<float>(mr, sizes, 2.0f);
+  ASSERT_EQ(jagged.size(), sizes.size());
+  for (std::size_t i = 0; i < sizes.size(); i++) {
+    ASSERT_EQ(jagged[i].size(), sizes[i]);
+    for (float x : jagged[i])
+      EXPECT_EQ(x, 2.0f);
+  }
+  delete &jagged;
+
+  std::vector<std::size_t> offsets = {0, 4, 4, 9};
+  vecpar::collection::csr_vector<int> &from_offsets =
+      vecpar::omp::parallel_make_jagged_from_offsets<int>(mr, offsets, 7);
+  ASSERT_EQ(from_offsets.size(), 3u);
+  EXPECT_EQ(from_offsets[0].size(), 4u);
+  EXPECT_EQ(from_offsets[1].size(), 0u);
+  EXPECT_EQ(from_offsets[2].size(), 5u);
+  EXPECT_EQ(from_offsets[2][4], 7);
+  // the rows lie back to back in one buffer
+  EXPECT_EQ(from_offsets.values.size(), 9u);
+  EXPECT_EQ(from_offsets[2].data(), from_offsets.values.data() + 4);
+  delete &from_offsets;
+
+  vecpar::collection::csr_vector<int> &no_rows =
+      vecpar::omp::parallel_make_jagged_from_offsets<int>(
+          mr, std::vector<std::size_t>{}, 7);
+  EXPECT_EQ(no_rows.size(), 0u);
+  delete &no_rows;
+}
+
+TEST_P(CpuHostMemoryTest, Parallel_Map_Soa) {
+  test_algorithm_25 product;
+  test_algorithm_26 scale;
+
+  vecmem::vector<X> aos(GetParam(), &mr);
+  for (int i = 0; i < GetParam(); i++)
+    aos[i] = X{i % 7, i * 0.5};
+
+  vecpar::soa_vector<int, double> &soa =
+      vecpar::omp::parallel_to_soa(mr, aos, &X::a, &X::b);
+  ASSERT_EQ(soa.size(), aos.size());
+  for (int i = 0; i < GetParam(); i++) {
+    EXPECT_EQ(soa.field<0>()[i], aos[i].a);
+    EXPECT_EQ(soa.field<1>()[i], aos[i].b);
+  }
+
+  vecmem::vector<double> &result = vecpar::omp::parallel_map(product, mr, soa);
+  for (int i = 0; i < GetParam(); i++) {
+    EXPECT_EQ(result[i], aos[i].f());
+  }
+
+  double factor = 3.0;
+  vecpar::omp::parallel_map(scale, mr, soa, factor);
+  vecmem::vector<X> &back = vecpar::omp::parallel_to_aos(mr, soa, &X::a, &X::b);
+  ASSERT_EQ(back.size(), aos.size());
+  for (int i = 0; i < GetParam(); i++) {
+    EXPECT_EQ(back[i].a, aos[i].a);
+    EXPECT_EQ(back[i].b, aos[i].b * factor);
+  }
+
+  delete &soa;
+  delete &result;
+  delete &back;
+}
+
+TEST_P(CpuHostMemoryTest, Parallel_Zip_Map) {
+  test_algorithm_27 weighted_sum;
+  test_algorithm_28 dot3;
+  static_assert(test_algorithm_27::input_count == 7);
+  static_assert(test_algorithm_28::input_count == 7);
+
+  std::vector<vecmem::vector<double>> x(6, vecmem::vector<double>(&mr));
+  for (std::size_t k = 0; k < x.size(); k++) {
+    x[k].resize(GetParam());
+    for (int i = 0; i < GetParam(); i++)
+      x[k][i] = (k + 1) * i * 0.5;
+  }
+  double w = 2.0;
+
+  vecmem::vector<double> &result = vecpar::omp::parallel_map(
+      weighted_sum, mr, x[0], x[1], x[2], x[3], x[4], x[5], *vec, w);
+  for (int i = 0; i < GetParam(); i++) {
+    EXPECT_DOUBLE_EQ(result[i], w * (21 * i * 0.5 + vec->at(i)));
+  }
+
+  vecmem::vector<double> y(GetParam(), &mr);
+  for (int i = 0; i < GetParam(); i++)
+    y[i] = 1.0;
+  vecpar::omp::parallel_map(dot3, mr, y, x[0], x[1], x[2], x[3], x[4], x[5]);
+  for (int i = 0; i < GetParam(); i++) {
+    const double v = i * 0.5;
+    EXPECT_DOUBLE_EQ(y[i], 1.0 + (1 * 2 + 3 * 4 + 5 * 6) * v * v);
+  }
+
+  delete &result;
+}
+
+TEST_P(CpuHostMemoryTest, Parallel_Map_Lazy_Inputs) {
+  test_algorithm_1 alg;
+
+  // 0, 1, ..., N - 1 without allocating and filling an input collection
+  vecmem::vector<double> &result =
+      vecpar::omp::parallel_map(alg, mr, vecpar::counting(GetParam()));
+  for (int i = 0; i < result.size(); i++)
+    EXPECT_EQ(result[i], i * 1.0);
+
+  double total =
+      vecpar::omp::parallel_algorithm(alg, mr, vecpar::counting(GetParam()));
+  EXPECT_EQ(total, expectedReduceResult);
+
+  auto doubled = vecpar::transformed(*vec, [](int x) { return 2 * x; });
+  EXPECT_EQ(vecpar::omp::parallel_map_reduce(alg, vecpar::reducers::sum(), mr,
+                                             doubled),
+            2 * expectedReduceResult);
+
+  // lazy ranges as additional collections
+  test_algorithm_6 axpy;
+  vecmem::vector<float> y(GetParam(), &mr);
+  float a = 2.0;
+  vecpar::omp::parallel_map(axpy, mr, y, vecpar::counting(0.0f, y.size()), a);
+  vecpar::omp::parallel_map(axpy, mr, y, vecpar::constant(1.0f, y.size()), a);
+  for (int i = 0; i < y.size(); i++)
+    EXPECT_EQ(y[i], i * a + a);
+
+  // reduce and filter read lazy ranges too
+  EXPECT_EQ(vecpar::omp::parallel_reduce(vecpar::reducers::sum(), mr,
+                                         vecpar::counting(0.0, GetParam())),
+            expectedReduceResult);
+  test_algorithm_20 at_least(GetParam() / 2);
+  vecmem::vector<int> &upper =
+      vecpar::omp::parallel_filter(at_least, mr, vecpar::counting(GetParam()));
+  std::sort(upper.begin(), upper.end());
+  ASSERT_EQ(upper.size(), GetParam() - GetParam() / 2);
+  for (int i = 0; i < upper.size(); i++)
+    EXPECT_EQ(upper[i], GetParam() / 2 + i);
+
+  // a transformed temporary lazy range is kept by value
+  auto odd = vecpar::transformed(vecpar::counting(0.0, GetParam()),
+                                 [](double x) { return 2 * x + 1; });
+  EXPECT_EQ(vecpar::omp::parallel_reduce(vecpar::reducers::sum(), mr, odd),
+            2 * expectedReduceResult + GetParam());
+
+  cleanup::free(result);
+  cleanup::free(y);
+  cleanup::free(upper);
+}
+
+TEST_P(CpuHostMemoryTest, Parallel_Map_Views) {
+  test_algorithm_1 alg;
+
+  // the second half of the input, without copying it
+  const std::size_t offset = vec->size() / 2;
+  vecmem::vector<double> &result = vecpar::omp::parallel_map(
+      alg, mr, vecpar::subrange(*vec, offset, vec->size() - offset));
+  ASSERT_EQ(result.size(), vec->size() - offset);
+  for (int i = 0; i < result.size(); i++)
+    EXPECT_EQ(result[i], (offset + i) * 1.0);
+
+  // every second element is updated in place, from a strided input
+  test_algorithm_6 axpy;
+  vecmem::vector<float> x(GetParam(), &mr);
+  vecmem::vector<float> y(GetParam(), 1.0f, &mr);
+  for (int i = 0; i < x.size(); i++)
+    x[i] = i;
+  float a = 2.0;
+  vecpar::config c{2, 3};
+  vecpar::omp::parallel_map(axpy, mr, c, vecpar::strided(y, 1, 2),
+                            vecpar::strided(x, 1, 2), a);
+  for (int i = 0; i < y.size(); i++)
+    EXPECT_EQ(y[i], i % 2 == 1 ? a * i + 1.0f : 1.0f);
+
+  // the viewed elements have to lie within the vector
+  EXPECT_THROW(vecpar::subrange(x, x.size(), 1), std::out_of_range);
+  EXPECT_THROW(vecpar::subrange(x, 1, x.size()), std::out_of_range);
+  EXPECT_THROW(vecpar::strided(x, x.size() + 1, 2), std::out_of_range);
+  EXPECT_THROW(vecpar::strided(x, 0, 0), std::invalid_argument);
+  EXPECT_THROW(vecpar::subrange(static_cast<float *>(nullptr), 1),
+               std::invalid_argument);
+  EXPECT_EQ(vecpar::subrange(x, x.size(), 0).size(), 0);
+  EXPECT_EQ(vecpar::strided(x, x.size(), 2).size(), 0);
+
+  cleanup::free(result);
+  cleanup::free(x);
+  cleanup::free(y);
+}
+
+TEST_P(CpuHostMemoryTest, Parallel_Map_Std_Containers) {
+  test_algorithm_1 alg;
+
+  // buffers of other libraries are wrapped without copying
+  std::vector<int> input(vec->begin(), vec->end());
+  std::span<int> input_span(input);
+
+  std::vector<double> result;
+  vecpar::omp::parallel_map_into(alg, result, vecpar::view(input));
+  ASSERT_EQ(result.size(), input.size());
+  for (int i = 0; i < result.size(); i++)
+    EXPECT_EQ(result[i], i * 1.0);
+
+  // fixed-size output, e.g. a raw buffer
+  std::unique_ptr<double[]> buffer(new double[input.size()]);
+  vecpar::config c{2, 3};
+  vecpar::omp::parallel_map_into(
+      alg, vecpar::subrange(buffer.get(), input.size()), c,
+      vecpar::view(input_span));
+  for (int i = 0; i < input.size(); i++)
+    EXPECT_EQ(buffer[i], i * 1.0);
+
+  std::vector<double> too_small(1);
+  EXPECT_THROW(vecpar::omp::parallel_map_into(
+                   alg, vecpar::view(too_small),
+                   vecpar::subrange(input.data(), input.size())),
+               std::length_error);
+
+  // mmap over a std::vector
+  test_algorithm_6 axpy;
+  std::vector<float> y(input.size(), 1.0f);
+  vecmem::vector<float> x(GetParam(), &mr);
+  for (int i = 0; i < x.size(); i++)
+    x[i] = i;
+  float a = 2.0;
+  vecpar::omp::parallel_map(axpy, mr, vecpar::view(y), x, a);
+  for (int i = 0; i < y.size(); i++)
+    EXPECT_EQ(y[i], a * i + 1.0f);
+
+  cleanup::free(x);
+}
+
+TEST_P(CpuHostMemoryTest, Parallel_Map_Masked) {
+  test_algorithm_6 axpy;
+  const std::size_t size = GetParam();
+  vecmem::vector<float> x(size, &mr);
+  vecmem::vector<float> y(size, &mr);
+  float a = 2.0;
+
+  // dense (every other element) and sparse (every 100th element) masks
+  for (std::size_t step : {2, 100}) {
+    vecpar::collection::bitmask mask(vecpar::collection::bitmask_words(size),
+                                     0, &mr);
+    for (std::size_t i = 0; i < size; i++) {
+      x[i] = i;
+      y[i] = 1.0;
+      if (i % step == 0)
+        mask[i / vecpar::collection::bitmask_word_bits] |=
+            std::uint64_t(1) << (i % vecpar::collection::bitmask_word_bits);
+    }
+    vecmem::vector<float> &result =
+        vecpar::omp::parallel_map_masked(axpy, mr, mask, y, x, a);
+    EXPECT_EQ(&result, &y);
+    for (std::size_t i = 0; i < size; i++)
+      EXPECT_EQ(y[i], i % step == 0 ? a * i + 1.0f : 1.0f);
+  }
+
+  // a mask which does not cover the collection
+  vecpar::collection::bitmask short_mask(
+      vecpar::collection::bitmask_words(size) - 1, ~std::uint64_t(0), &mr);
+  EXPECT_THROW(vecpar::omp::parallel_map_masked(axpy, mr, short_mask, y, x, a),
+               std::length_error);
+
+  // the mask is computed from a filter over the updated collection
+  for (std::size_t i = 0; i < size; i++) {
+    x[i] = 1.0;
+    y[i] = i;
+  }
+  test_algorithm_22 upper_half(size / 2);
+  vecpar::config c{2, 4};
+  vecpar::omp::parallel_map_where(axpy, upper_half, mr, c, y, x, a);
+  for (std::size_t i = 0; i < size; i++)
+    EXPECT_EQ(y[i], i >= size / 2 ? i + a : i * 1.0f);
+
+  cleanup::free(x);
+  cleanup::free(y);
+}
+
 INSTANTIATE_TEST_SUITE_P(Trivial_HostMemory, CpuHostMemoryTest,
                          testing::ValuesIn(N));
 } // namespace
@@ -2,6 +2,7 @@
 #include <gtest/gtest.h>
 
 #include <iterator>
+#include <vector>
 #include <vecmem/containers/jagged_vector.hpp>
 #include <vecmem/containers/vector.hpp>
 #include <vecmem/memory/host_memory_resource.hpp>
@@ -19,8 +20,14 @@
 // #include "../../common/algorithm/test_algorithm_8.hpp"
 
 // #include "../../common/algorithm/test_algorithm_10.hpp"
+#include "../../common/algorithm/test_algorithm_12.hpp"
+#include "../../common/algorithm/test_algorithm_13.hpp"
+#include "../../common/algorithm/test_algorithm_21.hpp"
+#include "../../common/algorithm/test_algorithm_27.hpp"
+#include "../../common/algorithm/test_algorithm_28.hpp"
 // #include "../../common/algorithm/test_algorithm_9.hpp"
 #include "../../common/infrastructure/cleanup.hpp"
+#include "vecpar/core/definitions/views.hpp"
 #include "vecpar/ompt/ompt_parallelization.hpp"
 
 namespace {
@@ -303,6 +310,63 @@ TEST_P(CpuHostMemoryTest, Parallel_Map_Extra_Param) {
   printf("mismatched values %d\n", count);
 }
 
+TEST_P(CpuHostMemoryTest, Parallel_Map_Indexed) {
+  test_algorithm_21 alg;
+  double weight = 2.0;
+
+  vecmem::vector<double> result =
+      vecpar::ompt::parallel_map(alg, mr, *vec, weight);
+  for (std::size_t i = 0; i < result.size(); i++)
+    EXPECT_EQ(result[i], 3.0 * i);
+}
+
+TEST_P(CpuHostMemoryTest, Parallel_Map_Std_Containers) {
+  test_algorithm_1 alg;
+
+  std::vector<int> input(vec->begin(), vec->end());
+  vecmem::vector<double> result =
+      vecpar::ompt::parallel_map(alg, mr, vecpar::view(input));
+  ASSERT_EQ(result.size(), input.size());
+  for (std::size_t i = 0; i < result.size(); i++)
+    EXPECT_EQ(result[i], i * 1.0);
+
+  // part of a vector, mapped as pointer and size
+  const std::size_t offset = vec->size() / 2;
+  vecmem::vector<double> half = vecpar::ompt::parallel_map(
+      alg, mr, vecpar::subrange(*vec, offset, vec->size() - offset));
+  ASSERT_EQ(half.size(), vec->size() - offset);
+  for (std::size_t i = 0; i < half.size(); i++)
+    EXPECT_EQ(half[i], (offset + i) * 1.0);
+}
+
+TEST_P(CpuHostMemoryTest, Parallel_Zip_Map) {
+  test_algorithm_27 weighted_sum;
+  test_algorithm_28 dot3;
+
+  std::vector<vecmem::vector<double>> x(6, vecmem::vector<double>(&mr));
+  for (std::size_t k = 0; k < x.size(); k++) {
+    x[k].resize(GetParam());
+    for (int i = 0; i < GetParam(); i++)
+      x[k][i] = (k + 1) * i * 0.5;
+  }
+  double w = 2.0;
+
+  vecmem::vector<double> result = vecpar::ompt::parallel_map(
+      weighted_sum, mr, x[0], x[1], x[2], x[3], x[4], x[5], *vec, w);
+  ASSERT_EQ(result.size(), vec->size());
+  for (int i = 0; i < GetParam(); i++)
+    EXPECT_DOUBLE_EQ(result[i], w * (21 * i * 0.5 + vec->at(i)));
+
+  vecmem::vector<double> y(GetParam(), &mr);
+  for (int i = 0; i < GetParam(); i++)
+    y[i] = 1.0;
+  vecpar::ompt::parallel_map(dot3, mr, y, x[0], x[1], x[2], x[3], x[4], x[5]);
+  for (int i = 0; i < GetParam(); i++) {
+    const double v = i * 0.5;
+    EXPECT_DOUBLE_EQ(y[i], 1.0 + (1 * 2 + 3 * 4 + 5 * 6) * v * v);
+  }
+}
+
 /*
 TEST_P(CpuHostMemoryTest, two_collections) {
   test_algorithm_6 alg;
@@ -493,6 +557,56 @@ TEST_P(CpuHostMemoryTest, five_jagged) {
   cleanup::free(expected);
 }
 */
+TEST_P(CpuHostMemoryTest, Parallel_Filter_Jagged) {
+  test_algorithm_12 alg;
+
+  // rows of different (and zero) lengths
+  vecmem::jagged_vector<int> x(GetParam(), &mr);
+  for (int i = 0; i < GetParam(); i++)
+    for (int j = 0; j < i % 7; j++)
+      x[i].push_back(i + j);
+
+  vecmem::jagged_vector<int> result =
+      vecpar::ompt::parallel_filter(alg, mr, x);
+
+  EXPECT_EQ(result.size(), x.size());
+  for (int i = 0; i < GetParam(); i++) {
+    vecmem::vector<int> expected(&mr);
+    for (int j = 0; j < i % 7; j++)
+      if ((i + j) % 3 == 0)
+        expected.push_back(i + j);
+    EXPECT_EQ(result[i].size(), expected.size());
+    for (int j = 0; j < result[i].size(); j++)
+      EXPECT_EQ(result[i][j], expected[j]);
+  }
+
+  cleanup::free(x);
+  cleanup::free(result);
+}
+
+TEST_P(CpuHostMemoryTest, Parallel_Reduce_Jagged) {
+  test_algorithm_13 alg;
+
+  vecmem::jagged_vector<double> x(GetParam(), &mr);
+  double expected = 0;
+  for (int i = 0; i < GetParam(); i++)
+    for (int j = 0; j < i % 7; j++) {
+      x[i].push_back(j * 1.0);
+      expected += j * 1.0;
+    }
+
+  double result = vecpar::ompt::parallel_reduce(alg, mr, x);
+  EXPECT_EQ(result, expected);
+
+  vecmem::vector<double> rows =
+      vecpar::ompt::parallel_reduce_rows(alg, mr, x);
+  EXPECT_EQ(rows.size(), x.size());
+  for (int i = 0; i < GetParam(); i++)
+    EXPECT_EQ(rows[i], (i % 7) * (i % 7 - 1) / 2 * 1.0);
+
+  cleanup::free(x);
+}
+
 INSTANTIATE_TEST_SUITE_P(Trivial_HostMemory, CpuHostMemoryTest,
                          testing::ValuesIn(N));
 } // namespace
@@ -13,6 +13,7 @@
 #include "../../common/algorithm/benchmark/daxpy.hpp"
 
 #include "../../common/infrastructure/cleanup.hpp"
+#include "vecpar/core/definitions/aligned_memory_resource.hpp"
 #include "vecpar/all/chain.hpp"
 #include "vecpar/all/main.hpp"
 
@@ -220,6 +221,53 @@ TEST_P(PerformanceTest_HostDevice, Saxpy) {
         cleanup::free(*y);
     }
 
+#if !(defined(__CUDA__) && defined(__clang__))
+/// times the same axpy on vectors from the default host resource and from
+/// the aligned, huge-page backed one
+template <class T, class Algorithm>
+void benchmark_aligned(Algorithm &alg, vecmem::memory_resource &mr, int n,
+                       const char *csv) {
+  vecpar::aligned_memory_resource aligned_mr;
+  double times[2];
+  vecmem::memory_resource *resources[2] = {&mr, &aligned_mr};
+  T a = 2.0;
+
+  for (int r = 0; r < 2; r++) {
+    vecmem::vector<T> *x = new vecmem::vector<T>(n, resources[r]);
+    vecmem::vector<T> *y = new vecmem::vector<T>(n, resources[r]);
+    // untimed run first, so that both measurements find warm caches
+    vecpar::parallel_algorithm(alg, *resources[r], *y, *x, a);
+    vecpar::parallel_generate(*x, [](std::size_t i) { return T(int(i) % 100); });
+    vecpar::parallel_generate(
+        *y, [](std::size_t i) { return T((int(i) - 1) % 100); });
+
+    auto start_time = std::chrono::steady_clock::now();
+    vecpar::parallel_algorithm(alg, *resources[r], *y, *x, a);
+    auto end_time = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) {
+      EXPECT_EQ(y->at(i), T((i - 1) % 100) + T(i % 100) * a);
+    }
+    times[r] = std::chrono::duration<double>(end_time - start_time).count();
+
+    cleanup::free(*x);
+    cleanup::free(*y);
+  }
+  printf("default memory time = %f s\n", times[0]);
+  printf("aligned memory time = %f s\n", times[1]);
+  write_to_csv(csv, n, times[0], times[1]);
+}
+
+TEST_P(PerformanceTest_HostDevice, Saxpy_Aligned_Memory) {
+  saxpy alg;
+  benchmark_aligned<float>(alg, mr, GetParam(), "cpu_saxpy_aligned_hd.csv");
+}
+
+TEST_P(PerformanceTest_HostDevice, Daxpy_Aligned_Memory) {
+  daxpy alg;
+  benchmark_aligned<double>(alg, mr, GetParam(), "cpu_daxpy_aligned_hd.csv");
+}
+#endif
+
 INSTANTIATE_TEST_SUITE_P(PerformanceTest_HostDevice, PerformanceTest_HostDevice,
                          testing::ValuesIn(N));
 } // end namespace
\ No newline at end of file
@@ -17,6 +17,7 @@
 
 #include "../../common/algorithm/test_algorithm_10.hpp"
 #include "../../common/algorithm/test_algorithm_11.hpp"
+#include "../../common/algorithm/test_algorithm_27.hpp"
 #include "../../common/infrastructure/cleanup.hpp"
 #include "vecpar/all/chain.hpp"
 #include "vecpar/all/main.hpp"
@@ -334,6 +335,28 @@ TEST_P(SingleSourceHostDeviceMemoryTest, jagged_chained) {
   cleanup::free(expected);
 }
 
+TEST_P(SingleSourceHostDeviceMemoryTest, Parallel_Zip_Map) {
+  test_algorithm_27 alg;
+
+  std::vector<vecmem::vector<double>> x(6, vecmem::vector<double>(&mr));
+  for (size_t k = 0; k < x.size(); k++) {
+    x[k].resize(GetParam());
+    for (int i = 0; i < GetParam(); i++)
+      x[k][i] = (k + 1) * i * 0.5;
+  }
+  double w = 2.0;
+
+  vecmem::vector<double> result = vecpar::parallel_algorithm(
+      alg, mr, x[0], x[1], x[2], x[3], x[4], x[5], *vec, w);
+
+  EXPECT_EQ(result.size(), vec->size());
+  for (int i = 0; i < GetParam(); i++) {
+    EXPECT_DOUBLE_EQ(result.at(i), w * (21 * i * 0.5 + vec->at(i)));
+  }
+
+  cleanup::free(result);
+}
+
 INSTANTIATE_TEST_SUITE_P(HostDeviceMemory, SingleSourceHostDeviceMemoryTest,
                          testing::ValuesIn(N));
 } // namespace